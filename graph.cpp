@@ -11,6 +11,35 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <functional>
+#include <climits>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <cstdlib>
+#include <iterator>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 using namespace std;
 
 
@@ -30,6 +59,57 @@ void printGraph(vector<int> adj[], int v){
     }
 }
 
+// Visited set - 1 bit per vertex instead of bool visited[v] (1 byte per vertex, on the stack)
+/* Bits are stored in 64 bit words on the heap
+Every word also has a stamp, a word is valid only if its stamp = current epoch, else all its bits are 0
+    - clear() just increments the epoch, so a reused set does not need O(v) initialisation
+    - words are zeroed lazily when first written in the new epoch
+Memory - 64 + 32 bits per 64 vertices, ~1.5 bits per vertex
+*/
+struct VisitedSet{
+    vector<uint64_t> bits;
+    vector<uint32_t> stamp;
+    uint32_t epoch = 0;
+
+    VisitedSet(int n = 0){
+        clear(n);
+    }
+
+    // Makes the set empty and able to hold vertices 0 to n - 1
+    void clear(int n){
+        int words = (n + 63) / 64;
+        if(words > (int)bits.size()){
+            bits.resize(words, 0);
+            stamp.resize(words, 0);
+        }
+        epoch++;
+        if(epoch == 0){ // Wrapped around, old stamps could match again
+            fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    bool test(int i) const{
+        int w = i >> 6;
+        return stamp[w] == epoch && (bits[w] >> (i & 63) & 1);
+    }
+
+    void set(int i){
+        int w = i >> 6;
+        if(stamp[w] != epoch){
+            stamp[w] = epoch;
+            bits[w] = 0;
+        }
+        bits[w] |= 1ULL << (i & 63);
+    }
+
+    void reset(int i){
+        int w = i >> 6;
+        if(stamp[w] == epoch)
+            bits[w] &= ~(1ULL << (i & 63));
+    }
+};
+
 // Breadth First Search(BFS)
 //------------------------------------------------------------------------------------------------------------------
 /* Version 1 - Source given
@@ -40,21 +120,21 @@ Time complexity - O(v + E), v = vertices, E = edges
 gives edges in directed graph and 2*edges in undirected graph
 Space complexity - O(v)
 */
-void BFS1(vector<int> adj[], int v, int source){
-    bool visited[v];
-    for(int i = 0; i < v; i++)
-        visited[i] = false; // Initially no vertex is added to the queue
+void BFS1(vector<int> adj[], int v, int source, bool print = true){
+    static thread_local VisitedSet visited;    // Reused by every call, clear() is O(1)
+    visited.clear(v); // Initially no vertex is added to the queue
     queue<int> q;
     q.push(source);
-    visited[source] = true; // When added to queue, visited becomes true
+    visited.set(source); // When added to queue, visited becomes true
     while(q.empty() == false){
         int u = q.front();
-        cout << u << " ";
+        if(print)
+            cout << u << " ";
         q.pop();
         for(int x : adj[u]){
-            if(visited[x] == false){
+            if(visited.test(x) == false){
                 q.push(x);
-                visited[x] = true;
+                visited.set(x);
             }
         }
     }
@@ -63,31 +143,30 @@ void BFS1(vector<int> adj[], int v, int source){
 /* Version 2 - Source not given, graph maybe diconnected as well
 Print all vertices in level order, considering any vertex as source
 */
-void BFS2(vector<int> adj[], int source, bool visited[]){
+void BFS2(vector<int> adj[], int source, VisitedSet &visited, bool print = true){
     queue<int> q;
     q.push(source);
-    visited[source] = true;
+    visited.set(source);
     
     while(q.empty() == false){
         int u = q.front();
-        cout << u << " ";
+        if(print)
+            cout << u << " ";
         q.pop();
         for(int x : adj[u]){
-            if(visited[x] == false){
+            if(visited.test(x) == false){
                 q.push(x);
-                visited[x] = true;
+                visited.set(x);
             }
         }
     }  
 }
 
 void BFSDis(vector<int> adj[], int v){
-    bool visited[v];
-    for(int i = 0; i < v; i++){
-        visited[i] = false;
-    }
+    static thread_local VisitedSet visited;
+    visited.clear(v);
     for(int i = 0; i < v; i++){
-        if(visited[i] == false)
+        if(visited.test(i) == false)
             BFS2(adj, i, visited);  // Calling for nodes that are not visited as source 
     }
 }
@@ -98,13 +177,12 @@ void BFSDis(vector<int> adj[], int v){
 Minor changes to BFS Version 2
 */
 int islandBFS(vector<int> adj[], int v){
-    bool visited[v];
+    static thread_local VisitedSet visited;
     int count = 0;
-    for(int i = 0; i < v; i++)
-        visited[i] = false;
+    visited.clear(v);
     for(int i = 0; i < v; i++){
-        if(visited[i] == false){
-            BFS2(adj, i, visited);  // Since we don't want to print the nodes, omit **cout << u << " "** in BFS2
+        if(visited.test(i) == false){
+            BFS2(adj, i, visited, false);  // false - since we don't want to print the nodes
             count++;
         }
     }
@@ -116,45 +194,76 @@ int islandBFS(vector<int> adj[], int v){
 Recursively call for 1 adjacent and then for other
 Time Complexity - O(V + E); explanation in BFS  
 */
-void DFSRec(vector<int> adj[], int source, bool visited[]){
-    visited[source] = true;
-    cout << source << " ";
+void DFSRec(vector<int> adj[], int source, VisitedSet &visited, bool print = true){
+    visited.set(source);
+    if(print)
+        cout << source << " ";
     for(int x : adj[source]){   // For next adjacent
-        if(visited[x] == false)
-            DFSRec(adj, x, visited);
+        if(visited.test(x) == false)
+            DFSRec(adj, x, visited, print);
     }
 }
 
-// For initialising visited and calling DFSRec()
-void DFS(vector<int> adj[], int v, int source){
-    bool visited[v];
-    for(int i = 0; i < v; i++)
-        visited[i] = false;
-    DFSRec(adj, source, visited);
+// Iterative DFS - same order as DFSRec()
+/* Recursive DFS uses one native stack frame per vertex on the current path,
+so a long chain (~10^6 vertices) overflows the stack
+Here the path is kept in an explicit stack of frames (vertex, index of next neighbour to try)
+    - a vertex is pushed only once, so v frames are always enough
+    - st[] is allocated once by the caller and reused for every source
+    - moving to next neighbour = incrementing the index, returning = top--
+*/
+void DFSIter(vector<int> adj[], int source, VisitedSet &visited, pair<int, int> st[], bool print = true){
+    int top = 0;
+    st[0] = {source, 0};
+    visited.set(source);
+    if(print)
+        cout << source << " ";
+    while(top >= 0){
+        int u = st[top].first;
+        if(st[top].second < (int)adj[u].size()){
+            int x = adj[u][st[top].second++];
+            if(visited.test(x) == false){
+                visited.set(x);
+                if(print)
+                    cout << x << " ";
+                st[++top] = {x, 0}; // Same as the recursive call DFSRec(adj, x, visited)
+            }
+        }
+        else
+            top--;  // All neighbours done
+    }
+}
+
+// For initialising visited and calling DFSIter(), stack safe version of DFSRec()
+void DFS(vector<int> adj[], int v, int source, bool print = true){
+    static thread_local VisitedSet visited;
+    visited.clear(v);
+    vector<pair<int, int>> st(v);
+    DFSIter(adj, source, visited, st.data(), print);
 }
 
 // Version 2 - For disconnected graph and source not given
 
 void DFSDis(vector<int> adj[], int v){
-    bool visited[v];
-    for(int i = 0; i < v; i++)
-        visited[i] = false;
+    static thread_local VisitedSet visited;
+    visited.clear(v);
+    vector<pair<int, int>> st(v);   // One buffer for all the sources
     for(int i = 0; i < v; i++){
-        if(visited[i] == false)
-            DFSRec(adj, i, visited);
+        if(visited.test(i) == false)
+            DFSIter(adj, i, visited, st.data());
     }
 }
 
 // Count componenets in an undirected graph
 // Changes in version 2 itself 
-int islandDFS(vector<int> adj[], int v, bool visited[]){
-    bool visited[v];
-    for(int i = 0; i < v; i++)
-        visited[i] = false;
+int islandDFS(vector<int> adj[], int v){
+    static thread_local VisitedSet visited;
+    visited.clear(v);
+    vector<pair<int, int>> st(v);
     int count = 0;
     for(int i = 0; i < v; i++){
-        if(visited[i] == false){
-            DFSRec(adj, v, visited);    // Omit cout << source << " " to avoid printing the graph
+        if(visited.test(i) == false){
+            DFSIter(adj, i, visited, st.data(), false);    // false - to avoid printing the graph
             count++;    // Should be written later always
         }
     }
@@ -165,28 +274,32 @@ int islandDFS(vector<int> adj[], int v, bool visited[]){
 /* Shortest path from source to all other vertices
 */
 
-void shortestPath(vector<int> adj[], int v, int source){
-    int dist[v]; 
+// Fills dist[] without printing, so that other versions and benchmarks can compare the result
+void shortestPathDist(vector<int> adj[], int v, int source, int dist[]){
     for(int i = 0; i < v; i++)
         dist[i] = INT16_MAX;    // Initialising infinity
     dist[source] = 0;   // Distance of source from source is 0
-    bool visited[v];    // if the node is visited or not
-    for(int i = 0; i < v; i++)
-        visited[i] = false;
+    static thread_local VisitedSet visited;
+    visited.clear(v);
     queue<int> q;
     q.push(source);
-    visited[source] = true;
+    visited.set(source);
     while(q.empty() == false){
         int u = q.front();
         q.pop();
         for(int x : adj[u]){
-            if(visited[x] == false){
+            if(visited.test(x) == false){
                 dist[x] = dist[u] + 1;  // DFS already takes shortest path
-                visited[x] = true;
+                visited.set(x);
                 q.push(x);
             }
         }
     }
+}
+
+void shortestPath(vector<int> adj[], int v, int source){
+    vector<int> dist(v);    // On the heap, int dist[v] overflows the stack for big v
+    shortestPathDist(adj, v, source, dist.data());
     // Printing desired output
     for(int i = 0; i < v; i++)
         cout << dist[i] << " ";
@@ -199,10 +312,10 @@ If the node is visited again and it's not the same as its origin(parent)
 then there is a cycle
 Time complexity - O(v + e)
 */
-bool DFS_Ucycle(vector<int> adj[], int i, bool visited[], int parent){
-    visited[i] = true;
+bool DFS_Ucycle(vector<int> adj[], int i, VisitedSet &visited, int parent){
+    visited.set(i);
     for(int u : adj[i]){
-        if(visited[u] == false){
+        if(visited.test(u) == false){
             if(DFS_Ucycle(adj, u, visited, i) == true){
                 return true;
             }
@@ -213,14 +326,38 @@ bool DFS_Ucycle(vector<int> adj[], int i, bool visited[], int parent){
     return false;
 }
 
+// Iterative version of DFS_Ucycle(), frames same as DFSIter()
+// Parent of a vertex is the vertex of the frame just below it
+bool DFS_UcycleIter(vector<int> adj[], int s, VisitedSet &visited, pair<int, int> st[]){
+    int top = 0;
+    st[0] = {s, 0};
+    visited.set(s);
+    while(top >= 0){
+        int i = st[top].first;
+        int parent = (top > 0) ? st[top - 1].first : -1;
+        if(st[top].second < (int)adj[i].size()){
+            int u = adj[i][st[top].second++];
+            if(visited.test(u) == false){
+                visited.set(u);
+                st[++top] = {u, 0};
+            }
+            else if(u != parent)
+                return true;
+        }
+        else
+            top--;
+    }
+    return false;
+}
+
 // Wrapper function to call and detect cycle
 bool Ucycle(vector<int> adj[], int v){
-    bool visited[v];
-    for(int i = 0; i < v; i++)
-        visited[i] = false;
+    static thread_local VisitedSet visited;
+    visited.clear(v);
+    vector<pair<int, int>> st(v);
     for(int i = 0; i < v; i++){
-        if(visited[i] == false){
-            if(DFS_Ucycle(adj, i, visited , -1) == true){    // there is a cycle
+        if(visited.test(i) == false){
+            if(DFS_UcycleIter(adj, i, visited, st.data()) == true){    // there is a cycle
                 return true;
             }
         }
@@ -232,29 +369,55 @@ bool Ucycle(vector<int> adj[], int v){
 // Detect cycle in a directed graph - imp
 //--------------------------------------------------------------------------------------------------------------------------------------
 //Time complexity - O(v + e)
-bool DFS_Dcycle(vector<int> adj[], int i, bool visited[], bool recStack[]){
-    visited[i] = true;
-    recStack[i] = true;
+bool DFS_Dcycle(vector<int> adj[], int i, VisitedSet &visited, VisitedSet &recStack){
+    visited.set(i);
+    recStack.set(i);
     for(int u : adj[i]){
-        if(visited[u] == false && DFS_Dcycle(adj, u, visited, recStack))
+        if(visited.test(u) == false && DFS_Dcycle(adj, u, visited, recStack))
             return true;
-        else if(recStack[u] == true) // Already visited node - ancestor
+        else if(recStack.test(u) == true) // Already visited node - ancestor
             return true;
     }
-    recStack[i] = false;    // When the recursion for one node/vertex is over, for new node/vertex - new fresh values
+    recStack.reset(i);    // When the recursion for one node/vertex is over, for new node/vertex - new fresh values
+    return false;
+}
+
+// Iterative version of DFS_Dcycle()
+// recStack = vertices present in the explicit stack
+bool DFS_DcycleIter(vector<int> adj[], int s, VisitedSet &visited, VisitedSet &recStack, pair<int, int> st[]){
+    int top = 0;
+    st[0] = {s, 0};
+    visited.set(s);
+    recStack.set(s);
+    while(top >= 0){
+        int i = st[top].first;
+        if(st[top].second < (int)adj[i].size()){
+            int u = adj[i][st[top].second++];
+            if(visited.test(u) == false){
+                visited.set(u);
+                recStack.set(u);
+                st[++top] = {u, 0};
+            }
+            else if(recStack.test(u) == true)    // Ancestor
+                return true;
+        }
+        else{
+            recStack.reset(i);
+            top--;
+        }
+    }
     return false;
 }
 
 // For covering all vertices
 bool Dcycle(vector<int> adj[], int v){
-    bool visited[v], recStack[v];
-    for(int i = 0; i < v; i++){
-        visited[i] = false;
-        recStack[i] = false;
-    }
+    static thread_local VisitedSet visited, recStack;
+    visited.clear(v);
+    recStack.clear(v);
+    vector<pair<int, int>> st(v);
     for(int i = 0; i < v ; i++){
-        if(visited[i] == false){
-            if(DFS_Dcycle(adj, i, visited, recStack) == true)
+        if(visited.test(i) == false){
+            if(DFS_DcycleIter(adj, i, visited, recStack, st.data()) == true)
                 return true;
         }
     }
@@ -262,20 +425,2835 @@ bool Dcycle(vector<int> adj[], int v){
 } 
 //----------------------------------------------------------------------------------------------------------------------------------------
 
+// Strongly connected components (SCC) - iterative Tarjan's algorithm
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* SCC = maximal set of vertices where every vertex can reach every other vertex
+Dcycle() only says if a cycle exists, SCCs tell which vertices are in cycles
+(every SCC with more than 1 vertex, or a vertex with an edge to itself, is a cycle)
+Tarjan - one DFS
+    - index[u] = order in which u is discovered, low[u] = smallest index reachable from u's subtree
+      using vertices still on the SCC stack
+    - when all neighbours of u are done and low[u] == index[u], u is the root of an SCC:
+      pop the SCC stack till u, all popped vertices form one component
+DFS uses explicit frames like DFSIter(), so it is safe for millions of vertices
+comp[u] = component of u, components are numbered in reverse topological order (sink components first)
+Returns the no. of components
+Time complexity - O(v + e)
+*/
+int tarjanSCC(vector<int> adj[], int v, vector<int> &comp){
+    vector<int> index(v, -1), low(v), sccStack;
+    vector<char> onStack(v, 0);
+    vector<pair<int, int>> st(v);
+    comp.assign(v, -1);
+    int counter = 0, count = 0;
+    sccStack.reserve(v);
+
+    for(int s = 0; s < v; s++){
+        if(index[s] != -1)
+            continue;
+        int top = 0;
+        st[0] = {s, 0};
+        index[s] = low[s] = counter++;
+        sccStack.push_back(s);
+        onStack[s] = 1;
+        while(top >= 0){
+            int u = st[top].first;
+            if(st[top].second < (int)adj[u].size()){
+                int x = adj[u][st[top].second++];
+                if(index[x] == -1){ // Tree edge - same as the recursive call
+                    index[x] = low[x] = counter++;
+                    sccStack.push_back(x);
+                    onStack[x] = 1;
+                    st[++top] = {x, 0};
+                }
+                else if(onStack[x])  // Edge back into the current SCC stack
+                    low[u] = min(low[u], index[x]);
+            }
+            else{
+                if(low[u] == index[u]){ // u is root of an SCC
+                    int w;
+                    do{
+                        w = sccStack.back();
+                        sccStack.pop_back();
+                        onStack[w] = 0;
+                        comp[w] = count;
+                    }while(w != u);
+                    count++;
+                }
+                top--;
+                if(top >= 0)    // Returning to the parent
+                    low[st[top].first] = min(low[st[top].first], low[u]);
+            }
+        }
+    }
+    return count;
+}
+
+/* Condensation - every SCC becomes one vertex, dag[c] = components reachable by one edge from c
+Always a DAG, every edge is stored once (mark[] remembers the last component that added it)
+Time complexity - O(v + e)
+*/
+void condensation(vector<int> adj[], int v, const vector<int> &comp, int count, vector<vector<int>> &dag){
+    vector<int> start(count + 1, 0), members(v), mark(count, -1);
+    for(int u = 0; u < v; u++)  // Vertices grouped by component (counting sort)
+        start[comp[u] + 1]++;
+    for(int c = 0; c < count; c++)
+        start[c + 1] += start[c];
+    vector<int> pos(start.begin(), start.end() - 1);
+    for(int u = 0; u < v; u++)
+        members[pos[comp[u]]++] = u;
+
+    dag.assign(count, vector<int>());
+    for(int c = 0; c < count; c++){
+        for(int k = start[c]; k < start[c + 1]; k++){
+            for(int x : adj[members[k]]){
+                int d = comp[x];
+                if(d != c && mark[d] != c){
+                    mark[d] = c;
+                    dag[c].push_back(d);
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Bridges and articulation points - iterative low link DFS
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Bridge - edge whose removal increases the no. of components
+Articulation point - vertex whose removal increases the no. of components
+Removing every edge and calling islandBFS() again is O(e * (v + e)), one DFS is enough
+    - disc[u] = discovery time of u, low[u] = smallest disc reachable from u's subtree using one back edge
+    - tree edge p - u is a bridge if low[u] > disc[p] (subtree of u can't reach p or above without it)
+    - non root p is an articulation point if low[u] >= disc[p] for some child u
+    - root is an articulation point if it has more than 1 child in the DFS tree
+Edge to the parent is skipped only once, so a repeated (parallel) edge works as a back edge
+Explicit frames like DFSIter(), safe for long chains. For undirected graph
+Time complexity - O(v + e)
+*/
+void bridgesAndArticulation(vector<int> adj[], int v, vector<pair<int, int>> &bridges, vector<int> &points){
+    vector<int> disc(v, -1), low(v, 0);
+    vector<char> isPoint(v, 0);
+    struct Frame{
+        int u, next, parent;
+        bool parentSkipped;
+    };
+    vector<Frame> st(v);
+    bridges.clear();
+    points.clear();
+    int timer = 0;
+
+    for(int s = 0; s < v; s++){
+        if(disc[s] != -1)
+            continue;
+        int rootChildren = 0, top = 0;
+        st[0] = {s, 0, -1, false};
+        disc[s] = low[s] = timer++;
+        while(top >= 0){
+            Frame &f = st[top];
+            int u = f.u;
+            if(f.next < (int)adj[u].size()){
+                int x = adj[u][f.next++];
+                if(x == f.parent && f.parentSkipped == false){
+                    f.parentSkipped = true;
+                    continue;
+                }
+                if(disc[x] == -1){  // Tree edge
+                    disc[x] = low[x] = timer++;
+                    if(u == s)
+                        rootChildren++;
+                    st[++top] = {x, 0, u, false};
+                }
+                else    // Back edge
+                    low[u] = min(low[u], disc[x]);
+            }
+            else{
+                top--;
+                int p = f.parent;
+                if(p != -1){    // Returning from child u to parent p
+                    low[p] = min(low[p], low[u]);
+                    if(low[u] > disc[p])
+                        bridges.push_back({p, u});
+                    if(p != s && low[u] >= disc[p])
+                        isPoint[p] = 1;
+                }
+            }
+        }
+        if(rootChildren > 1)
+            isPoint[s] = 1;
+    }
+    for(int i = 0; i < v; i++){
+        if(isPoint[i])
+            points.push_back(i);
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
 // Topological sorting 
 //----------------------------------------------------------------------------------------------------------------------------------------
 /* Vertices are jobs and edges are dependencies
 Dependent Jobs should appear first followed by the dependencies 
 */
-/*Method 1 - BFS approach
+/*Method 1 - BFS approach (Kahn's algorithm)
+Approach - Indegree of a vertex = no. of jobs it depends upon
+         - Jobs with indegree 0 can be done first, push them in a queue
+         - Pop a job, add it to the order and reduce indegree of all its adjacent jobs by 1
+         - Adjacent job whose indegree becomes 0 is pushed in the queue
+If the graph has a cycle, jobs of the cycle never reach indegree 0 so order has less than v jobs
+Returns true if there is a cycle (same as Dcycle()), order is complete only when it returns false
+Time complexity - O(v + e)
+*/
+bool topologicalSort(vector<int> adj[], int v, vector<int> &order){
+    vector<int> indegree(v, 0);
+    for(int u = 0; u < v; u++){
+        for(int x : adj[u])
+            indegree[x]++;
+    }
+    queue<int> q;
+    for(int i = 0; i < v; i++){
+        if(indegree[i] == 0)
+            q.push(i);
+    }
+    order.clear();
+    while(q.empty() == false){
+        int u = q.front();
+        q.pop();
+        order.push_back(u);
+        for(int x : adj[u]){
+            if(--indegree[x] == 0)
+                q.push(x);
+        }
+    }
+    return (int)order.size() != v;
+}
+
+// Printing the order
+void topologicalSort(vector<int> adj[], int v){
+    vector<int> order;
+    if(topologicalSort(adj, v, order) == true){
+        cout << "Cycle" << endl;
+        return;
+    }
+    for(int x : order)
+        cout << x << " ";
+}
+
+/* Wavefront version - jobs grouped in levels instead of one order
+Level 0 = jobs with indegree 0, level k = jobs whose last dependency is in level k - 1
+Jobs of the same level do not depend upon each other, so they can be run at the same time
+Same as Kahn's algorithm, but the queue is processed one level at a time
+Returns true if there is a cycle, jobs of the cycle (and jobs depending on them) are in no level
+*/
+bool topologicalLevels(vector<int> adj[], int v, vector<vector<int>> &levels){
+    vector<int> indegree(v, 0);
+    for(int u = 0; u < v; u++){
+        for(int x : adj[u])
+            indegree[x]++;
+    }
+    levels.clear();
+    vector<int> curr;
+    for(int i = 0; i < v; i++){
+        if(indegree[i] == 0)
+            curr.push_back(i);
+    }
+    int done = 0;
+    while(curr.empty() == false){
+        vector<int> next;
+        for(int u : curr){
+            for(int x : adj[u]){
+                if(--indegree[x] == 0)
+                    next.push_back(x);
+            }
+        }
+        done += curr.size();
+        levels.push_back(move(curr));
+        curr = move(next);
+    }
+    return done != v;
+}
+
+// Barrier - every thread waits till all the threads have called wait()
+struct Barrier{
+    mutex m;
+    condition_variable cv;
+    int total, waiting = 0, generation = 0;
+
+    Barrier(int n){
+        total = n;
+    }
+
+    void wait(){
+        unique_lock<mutex> lock(m);
+        int gen = generation;
+        if(++waiting == total){ // Last thread releases everyone
+            waiting = 0;
+            generation++;
+            cv.notify_all();
+        }
+        else
+            cv.wait(lock, [&]{ return gen != generation; });
+    }
+};
+
+/* Runs job(u) for every vertex, level by level
+Jobs of one level are shared by the worker threads (next job picked using an atomic counter),
+next level starts only when all the jobs of the current level are finished
+Threads are created once and wait at a barrier between levels (creating threads for every level
+costs more than the jobs themselves when the DAG is deep and narrow)
+Returns true (and runs nothing) if there is a cycle
+*/
+bool runTopological(vector<int> adj[], int v, function<void(int)> job, int threads){
+    vector<vector<int>> levels;
+    if(topologicalLevels(adj, v, levels) == true)
+        return true;
+    size_t widest = 0;
+    for(auto &level : levels)
+        widest = max(widest, level.size());
+    int count = max(1, min<int>(threads, widest));
+    // One job counter per level, so nobody has to reset a counter between the levels
+    unique_ptr<atomic<size_t>[]> next(new atomic<size_t>[levels.size()]);
+    for(size_t l = 0; l < levels.size(); l++)
+        next[l].store(0, memory_order_relaxed);
+    Barrier sync(count);
+
+    auto worker = [&]{
+        for(size_t l = 0; l < levels.size(); l++){
+            for(size_t k = next[l].fetch_add(1); k < levels[l].size(); k = next[l].fetch_add(1))
+                job(levels[l][k]);
+            sync.wait();    // Jobs of the next level may use the results of this level
+        }
+    };
+    vector<thread> pool;
+    for(int t = 1; t < count; t++)
+        pool.emplace_back(worker);
+    worker();   // Calling thread also works
+    for(auto &th : pool)
+        th.join();
+    return false;
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Benchmark - recursive vs iterative DFS
+/* Random tree with v vertices (acyclic, so cycle detection visits every vertex)
+depth is limited so that the recursive versions do not overflow the stack
+*/
+void benchIterDFS(int v, int rounds = 10){
+    mt19937 rng(7);
+    vector<vector<int>> adjStore(v), dirStore(v);
+    vector<int> *adj = adjStore.data(), *dir = dirStore.data();
+    for(int i = 1; i < v; i++){
+        int p = max(0, i - 1 - (int)(rng() % 64));  // Parent among the previous 64 vertices
+        addEdge_UD(adj, p, i);
+        dir[p].push_back(i);
+    }
+    VisitedSet vis(v), rec(v);
+    vector<pair<int, int>> st(v);
+
+    auto timeIt = [&](const char *name, auto fn){
+        auto start = chrono::steady_clock::now();
+        for(int r = 0; r < rounds; r++){
+            vis.clear(v);
+            rec.clear(v);
+            fn();
+        }
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count() / rounds;
+        cout << name << " : " << secs << " s" << endl;
+    };
+    timeIt("DFS recursive   ", [&]{ DFSRec(adj, 0, vis, false); });
+    timeIt("DFS iterative   ", [&]{ DFSIter(adj, 0, vis, st.data(), false); });
+    timeIt("Ucycle recursive", [&]{ DFS_Ucycle(adj, 0, vis, -1); });
+    timeIt("Ucycle iterative", [&]{ DFS_UcycleIter(adj, 0, vis, st.data()); });
+    timeIt("Dcycle recursive", [&]{ DFS_Dcycle(dir, 0, vis, rec); });
+    timeIt("Dcycle iterative", [&]{ DFS_DcycleIter(dir, 0, vis, rec, st.data()); });
+}
+
+// Compressed Sparse Row (CSR) representation
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* vector<int> adj[] - every vertex owns a separate dynamic array, so neighbours are scattered in memory
+CSR - neighbours of all vertices are stored one after another in a single array
+    - nbr[offset[u]] ... nbr[offset[u + 1] - 1] are the neighbours of u
+    - offset has v + 1 entries, offset[v] = total no. of stored edges
+Space complexity - O(v + E), no per-vertex allocation
+*/
+struct CSRGraph{
+    int v;
+    vector<int> offset;
+    vector<int> nbr;
+
+    CSRGraph(int n){
+        v = n;
+        offset.assign(n + 1, 0);
+    }
+
+    // Returns no. of neighbours of the given vertex
+    int degree(int u) const{
+        return offset[u + 1] - offset[u];
+    }
+};
+
+// Edge list version of addEdge_UD - only records the edge, CSR is built once all edges are added
+void addEdge_UD(vector<pair<int, int>> &edges, int u, int v){
+    edges.push_back({u, v});
+}
+
+/* Building CSR from an edge list - counting sort on the source vertex
+Pass 1 - count degree of every vertex
+Pass 2 - prefix sum of degrees gives offset
+Pass 3 - place every edge at the next free position of its source
+For undirected graph both (u, v) and (v, u) are placed, same as addEdge_UD
+Time complexity - O(v + E)
+*/
+CSRGraph buildCSR(const vector<pair<int, int>> &edges, int v, bool undirected = true){
+    CSRGraph g(v);
+    for(auto &e : edges){
+        g.offset[e.first + 1]++;
+        if(undirected)
+            g.offset[e.second + 1]++;
+    }
+    for(int i = 0; i < v; i++)
+        g.offset[i + 1] += g.offset[i];
+    g.nbr.resize(g.offset[v]);
+    vector<int> pos(g.offset.begin(), g.offset.end() - 1);  // Next free position for every vertex
+    for(auto &e : edges){
+        g.nbr[pos[e.first]++] = e.second;
+        if(undirected)
+            g.nbr[pos[e.second]++] = e.first;
+    }
+    return g;
+}
+
+// Building CSR from an existing adjacency list, order of neighbours remains same
+CSRGraph buildCSR(vector<int> adj[], int v){
+    CSRGraph g(v);
+    for(int i = 0; i < v; i++)
+        g.offset[i + 1] = g.offset[i] + adj[i].size();
+    g.nbr.reserve(g.offset[v]);
+    for(int i = 0; i < v; i++)
+        g.nbr.insert(g.nbr.end(), adj[i].begin(), adj[i].end());
+    return g;
+}
+
+// All the traversals above, written for CSRGraph
+// Only change - for(int x : adj[u]) becomes a loop from offset[u] to offset[u + 1]
+
+void BFS1(const CSRGraph &g, int source){
+    static thread_local VisitedSet visited;
+    visited.clear(g.v);
+    queue<int> q;
+    q.push(source);
+    visited.set(source);
+    while(q.empty() == false){
+        int u = q.front();
+        cout << u << " ";
+        q.pop();
+        for(int i = g.offset[u]; i < g.offset[u + 1]; i++){
+            int x = g.nbr[i];
+            if(visited.test(x) == false){
+                q.push(x);
+                visited.set(x);
+            }
+        }
+    }
+}
+
+void BFS2(const CSRGraph &g, int source, VisitedSet &visited){
+    queue<int> q;
+    q.push(source);
+    visited.set(source);
+    while(q.empty() == false){
+        int u = q.front();
+        cout << u << " ";
+        q.pop();
+        for(int i = g.offset[u]; i < g.offset[u + 1]; i++){
+            int x = g.nbr[i];
+            if(visited.test(x) == false){
+                q.push(x);
+                visited.set(x);
+            }
+        }
+    }
+}
+
+void BFSDis(const CSRGraph &g){
+    static thread_local VisitedSet visited;
+    visited.clear(g.v);
+    for(int i = 0; i < g.v; i++){
+        if(visited.test(i) == false)
+            BFS2(g, i, visited);
+    }
+}
+
+// CSR DFS family is iterative like DFSIter(), frame = (vertex, position of next neighbour in nbr[])
+void DFSIter(const CSRGraph &g, int source, VisitedSet &visited, pair<int, int> st[]){
+    int top = 0;
+    st[0] = {source, g.offset[source]};
+    visited.set(source);
+    cout << source << " ";
+    while(top >= 0){
+        int u = st[top].first;
+        if(st[top].second < g.offset[u + 1]){
+            int x = g.nbr[st[top].second++];
+            if(visited.test(x) == false){
+                visited.set(x);
+                cout << x << " ";
+                st[++top] = {x, g.offset[x]};
+            }
+        }
+        else
+            top--;
+    }
+}
+
+void DFS(const CSRGraph &g, int source){
+    static thread_local VisitedSet visited;
+    visited.clear(g.v);
+    vector<pair<int, int>> st(g.v);
+    DFSIter(g, source, visited, st.data());
+}
+
+// Graph = CSRGraph or MappedGraph (anything with v, offset[], nbr[] and degree()), same code runs on both
+template<class Graph>
+void shortestPathDist(const Graph &g, int source, int dist[]){
+    for(int i = 0; i < g.v; i++)
+        dist[i] = INT16_MAX;
+    dist[source] = 0;
+    static thread_local VisitedSet visited;
+    visited.clear(g.v);
+    queue<int> q;
+    q.push(source);
+    visited.set(source);
+    while(q.empty() == false){
+        int u = q.front();
+        q.pop();
+        for(int i = g.offset[u]; i < g.offset[u + 1]; i++){
+            int x = g.nbr[i];
+            if(visited.test(x) == false){
+                dist[x] = dist[u] + 1;
+                visited.set(x);
+                q.push(x);
+            }
+        }
+    }
+}
+
+void shortestPath(const CSRGraph &g, int source){
+    vector<int> dist(g.v);
+    shortestPathDist(g, source, dist.data());
+    for(int i = 0; i < g.v; i++)
+        cout << dist[i] << " ";
+}
+
+bool DFS_UcycleIter(const CSRGraph &g, int s, VisitedSet &visited, pair<int, int> st[]){
+    int top = 0;
+    st[0] = {s, g.offset[s]};
+    visited.set(s);
+    while(top >= 0){
+        int i = st[top].first;
+        int parent = (top > 0) ? st[top - 1].first : -1;
+        if(st[top].second < g.offset[i + 1]){
+            int u = g.nbr[st[top].second++];
+            if(visited.test(u) == false){
+                visited.set(u);
+                st[++top] = {u, g.offset[u]};
+            }
+            else if(u != parent)
+                return true;
+        }
+        else
+            top--;
+    }
+    return false;
+}
+
+bool Ucycle(const CSRGraph &g){
+    static thread_local VisitedSet visited;
+    visited.clear(g.v);
+    vector<pair<int, int>> st(g.v);
+    for(int i = 0; i < g.v; i++){
+        if(visited.test(i) == false && DFS_UcycleIter(g, i, visited, st.data()) == true)
+            return true;
+    }
+    return false;
+}
+
+// For Dcycle build the CSR with undirected = false
+bool DFS_DcycleIter(const CSRGraph &g, int s, VisitedSet &visited, VisitedSet &recStack, pair<int, int> st[]){
+    int top = 0;
+    st[0] = {s, g.offset[s]};
+    visited.set(s);
+    recStack.set(s);
+    while(top >= 0){
+        int i = st[top].first;
+        if(st[top].second < g.offset[i + 1]){
+            int u = g.nbr[st[top].second++];
+            if(visited.test(u) == false){
+                visited.set(u);
+                recStack.set(u);
+                st[++top] = {u, g.offset[u]};
+            }
+            else if(recStack.test(u) == true)
+                return true;
+        }
+        else{
+            recStack.reset(i);
+            top--;
+        }
+    }
+    return false;
+}
+
+bool Dcycle(const CSRGraph &g){
+    static thread_local VisitedSet visited, recStack;
+    visited.clear(g.v);
+    recStack.clear(g.v);
+    vector<pair<int, int>> st(g.v);
+    for(int i = 0; i < g.v; i++){
+        if(visited.test(i) == false && DFS_DcycleIter(g, i, visited, recStack, st.data()) == true)
+            return true;
+    }
+    return false;
+}
+
+// Benchmark - adjacency list vs CSR
+/* Random undirected graph with v vertices and e edges, same edges given to both representations
+Times repeated shortestPathDist() (no printing) from different sources and reports edges traversed per second
+*/
+void benchCSR(int v, int e, int rounds = 10){
+    mt19937 rng(42);
+    uniform_int_distribution<int> pick(0, v - 1);
+    vector<pair<int, int>> edges;
+    vector<vector<int>> adjStore(v);  // vector<int> adj[v] would not fit on stack for big v
+    vector<int> *adj = adjStore.data();
+    for(int i = 0; i < e; i++){
+        int a = pick(rng), b = pick(rng);
+        addEdge_UD(edges, a, b);
+        addEdge_UD(adj, a, b);
+    }
+    CSRGraph g = buildCSR(edges, v);
+    vector<int> dist1(v), dist2(v);
+
+    auto start = chrono::steady_clock::now();
+    for(int r = 0; r < rounds; r++)
+        shortestPathDist(adj, v, r % v, dist1.data());
+    double tAdj = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for(int r = 0; r < rounds; r++)
+        shortestPathDist(g, r % v, dist2.data());
+    double tCSR = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    double traversed = 2.0 * e * rounds;
+    cout << "adjacency list : " << tAdj << " s, " << traversed / tAdj << " edges/s" << endl;
+    cout << "CSR            : " << tCSR << " s, " << traversed / tCSR << " edges/s" << endl;
+    cout << "same distances : " << (dist1 == dist2 ? "yes" : "no") << endl;
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+
+// Transpose of a CSR graph - edge (u, x) becomes (x, u)
+// For undirected graph the transpose is the graph itself
+CSRGraph transposeCSR(const CSRGraph &g){
+    CSRGraph t(g.v);
+    for(int x : g.nbr)
+        t.offset[x + 1]++;
+    for(int i = 0; i < g.v; i++)
+        t.offset[i + 1] += t.offset[i];
+    t.nbr.resize(t.offset[g.v]);
+    vector<int> pos(t.offset.begin(), t.offset.end() - 1);
+    for(int u = 0; u < g.v; u++){
+        for(int i = g.offset[u]; i < g.offset[u + 1]; i++)
+            t.nbr[pos[g.nbr[i]]++] = u;
+    }
+    return t;
+}
+
+// Direction optimizing BFS - same dist[] as shortestPathDist()
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Top down step - every frontier vertex checks all its neighbours (what shortestPath does)
+                 - when frontier is large, most neighbours are already visited, so most checks are wasted
+Bottom up step - every unvisited vertex checks its parents (in-neighbours) and stops at the first one in the frontier
+               - frontier is kept as a bitmap, 1 bit per vertex
+Switching (Beamer's heuristic)
+    - top down -> bottom up, when edges of frontier (mf) > edges of unvisited vertices (mu) / alpha
+    - bottom up -> top down, when vertices in frontier (nf) < v / beta
+gin = transpose of g, used by bottom up step, pass g itself for undirected graph
+Time complexity - O(v + E) worst case, but on low diameter graphs most edges are never checked
 */
+template<class Graph, class InGraph>
+void hybridBFS(const Graph &g, const InGraph &gin, int source, int dist[], int alpha = 15, int beta = 18){
+    int n = g.v;
+    int words = (n + 63) / 64;
+    for(int i = 0; i < n; i++)
+        dist[i] = INT16_MAX;
+    vector<uint64_t> visited(words, 0), front(words, 0), next(words, 0);
+    vector<int> queueFront, queueNext;  // Frontier as list, used in top down step
+    dist[source] = 0;
+    visited[source >> 6] |= 1ULL << (source & 63);
+    queueFront.push_back(source);
 
+    long long mf = g.degree(source);    // Edges to check from frontier
+    long long mu = (long long)g.offset[n] - mf;   // Edges to check from unvisited vertices
+    long long nf = 1;
+    bool bottomUp = false;
+    for(int level = 1; nf > 0; level++){
+        if(bottomUp == false && mf > mu / alpha){
+            fill(front.begin(), front.end(), 0);    // List -> bitmap
+            for(int u : queueFront)
+                front[u >> 6] |= 1ULL << (u & 63);
+            bottomUp = true;
+        }
+        else if(bottomUp == true && nf < n / beta){
+            queueFront.clear(); // Bitmap -> list
+            for(int w = 0; w < words; w++){
+                for(uint64_t bits = front[w]; bits != 0; bits &= bits - 1)
+                    queueFront.push_back(w * 64 + __builtin_ctzll(bits));
+            }
+            bottomUp = false;
+        }
+
+        mf = 0;
+        nf = 0;
+        if(bottomUp == false){
+            queueNext.clear();
+            for(int u : queueFront){
+                for(int i = g.offset[u]; i < g.offset[u + 1]; i++){
+                    int x = g.nbr[i];
+                    if((visited[x >> 6] >> (x & 63) & 1) == 0){
+                        visited[x >> 6] |= 1ULL << (x & 63);
+                        dist[x] = level;
+                        queueNext.push_back(x);
+                        mf += g.degree(x);
+                    }
+                }
+            }
+            swap(queueFront, queueNext);
+            nf = queueFront.size();
+        }
+        else{
+            fill(next.begin(), next.end(), 0);
+            for(int x = 0; x < n; x++){
+                if(visited[x >> 6] >> (x & 63) & 1)
+                    continue;
+                for(int i = gin.offset[x]; i < gin.offset[x + 1]; i++){
+                    int p = gin.nbr[i];
+                    if(front[p >> 6] >> (p & 63) & 1){  // First parent found in frontier is enough
+                        next[x >> 6] |= 1ULL << (x & 63);
+                        dist[x] = level;
+                        mf += g.degree(x);
+                        nf++;
+                        break;
+                    }
+                }
+            }
+            for(int w = 0; w < words; w++)  // Marking after the scan, so a vertex is not used as parent in its own level
+                visited[w] |= next[w];
+            swap(front, next);
+        }
+        mu -= mf;
+    }
+}
 
+// For undirected graph, in-neighbours = neighbours
+template<class Graph>
+void hybridBFS(const Graph &g, int source, int dist[]){
+    hybridBFS(g, g, source, dist);
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
 
+// Parallel level synchronous BFS - same dist[] as shortestPathDist()
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Every level of BFS is processed by all threads together
+    - frontier is divided in small chunks, a thread picks the next chunk using an atomic counter
+    - visited is a bitmap of atomic words, fetch_or decides which thread discovers a vertex (only one thread wins)
+    - every thread collects discovered vertices in its own local buffer, no locking while traversing
+    - at the end of the level, local buffers are joined to form the next frontier
+Threads are created once and wait at a barrier between levels (Barrier is defined with runTopological())
+*/
+template<class Graph>
+void parallelBFS(const Graph &g, int source, int dist[], int threads){
+    const int CHUNK = 64;
+    int n = g.v;
+    int words = (n + 63) / 64;
+    unique_ptr<atomic<uint64_t>[]> visited(new atomic<uint64_t>[words]);
+    for(int w = 0; w < words; w++)
+        visited[w].store(0, memory_order_relaxed);
+    for(int i = 0; i < n; i++)
+        dist[i] = INT16_MAX;
+    dist[source] = 0;
+    visited[source >> 6].store(1ULL << (source & 63), memory_order_relaxed);
 
+    vector<int> frontier{source};
+    vector<vector<int>> local(threads);
+    atomic<size_t> cursor(0);
+    int level = 1;
+    bool done = false;
+    Barrier sync(threads);
 
-int main(){
-    int v = 4;
+    auto worker = [&](int t){
+        while(true){
+            for(size_t start = cursor.fetch_add(CHUNK); start < frontier.size(); start = cursor.fetch_add(CHUNK)){
+                size_t end = min(start + CHUNK, frontier.size());
+                for(size_t k = start; k < end; k++){
+                    int u = frontier[k];
+                    for(int i = g.offset[u]; i < g.offset[u + 1]; i++){
+                        int x = g.nbr[i];
+                        uint64_t bit = 1ULL << (x & 63);
+                        if(visited[x >> 6].load(memory_order_relaxed) & bit)    // Cheap check before the atomic write
+                            continue;
+                        if((visited[x >> 6].fetch_or(bit, memory_order_relaxed) & bit) == 0){
+                            dist[x] = level;
+                            local[t].push_back(x);
+                        }
+                    }
+                }
+            }
+            sync.wait();
+            if(t == 0){ // One thread prepares the next level
+                frontier.clear();
+                for(auto &buf : local){
+                    frontier.insert(frontier.end(), buf.begin(), buf.end());
+                    buf.clear();
+                }
+                cursor = 0;
+                level++;
+                done = frontier.empty();
+            }
+            sync.wait();
+            if(done)
+                break;
+        }
+    };
+
+    vector<thread> pool;
+    for(int t = 1; t < threads; t++)
+        pool.emplace_back(worker, t);
+    worker(0);  // Calling thread works as thread 0
+    for(auto &th : pool)
+        th.join();
+}
+
+// R-MAT generator - power law graph like real social/web graphs
+/* 2^scale vertices, edgeFactor * 2^scale edges
+Every edge picks one quadrant of the adjacency matrix at each of the scale levels
+with probabilities a, b, c and d = 1 - a - b - c
+*/
+vector<pair<int, int>> rmatEdges(int scale, int edgeFactor, unsigned seed = 1, double a = 0.57, double b = 0.19, double c = 0.19){
+    mt19937 rng(seed);
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    long long e = (long long)edgeFactor << scale;
+    vector<pair<int, int>> edges;
+    edges.reserve(e);
+    for(long long k = 0; k < e; k++){
+        int u = 0, v = 0;
+        for(int bit = scale - 1; bit >= 0; bit--){
+            double r = coin(rng);
+            if(r < a)
+                continue;
+            else if(r < a + b)
+                v |= 1 << bit;
+            else if(r < a + b + c)
+                u |= 1 << bit;
+            else{
+                u |= 1 << bit;
+                v |= 1 << bit;
+            }
+        }
+        edges.push_back({u, v});
+    }
+    return edges;
+}
+
+// Scaling benchmark - parallelBFS from 1 thread to all hardware threads on an R-MAT graph
+void benchParallelBFS(int scale, int edgeFactor = 16, int rounds = 5){
+    int v = 1 << scale;
+    CSRGraph g = buildCSR(rmatEdges(scale, edgeFactor), v);
+    vector<int> expected(v), dist(v);
+    int source = 0;
+    for(int i = 0; i < v; i++){   // Source with highest degree, so the BFS reaches the big component
+        if(g.degree(i) > g.degree(source))
+            source = i;
+    }
+    shortestPathDist(g, source, expected.data());
+
+    int maxThreads = max(1u, thread::hardware_concurrency());
+    double base = 0;
+    for(int t = 1; t <= maxThreads; t++){
+        auto start = chrono::steady_clock::now();
+        for(int r = 0; r < rounds; r++)
+            parallelBFS(g, source, dist.data(), t);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count() / rounds;
+        if(t == 1)
+            base = secs;
+        cout << t << " threads : " << secs << " s, speedup " << base / secs
+             << (dist == expected ? "" : "  WRONG DISTANCES") << endl;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Parallel connected components - concurrent union find
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Union find (disjoint set) - every vertex points to a parent, root of the tree = component
+    - find(x) - go up till the root, path halving: x points to its grandparent on the way
+    - unite(x, y) - root with smaller rank goes under the other root, rank = upper bound on height
+Many threads add edges at the same time without locks
+    - parent and rank of a vertex are kept in one 64 bit word (rank << 32 | parent), changed only by compare and swap (CAS)
+    - linking root x under y is a CAS that succeeds only if x is still a root with the same rank,
+      otherwise the roots are searched again
+    - ranks only increase and ties are broken by vertex id, so two roots can never link under each other
+Time complexity - O(E * alpha(v)) work in total, divided among the threads
+*/
+struct ConcurrentDSU{
+    int n;
+    unique_ptr<atomic<uint64_t>[]> word;
+
+    ConcurrentDSU(int v){
+        n = v;
+        word.reset(new atomic<uint64_t>[v]);
+        for(int i = 0; i < v; i++)
+            word[i].store((uint64_t)i, memory_order_relaxed);   // Rank 0, parent = itself
+    }
+
+    static int parentOf(uint64_t w){
+        return (int)(w & 0xffffffffu);
+    }
+
+    static uint32_t rankOf(uint64_t w){
+        return (uint32_t)(w >> 32);
+    }
+
+    int find(int x){
+        while(true){
+            uint64_t w = word[x].load();
+            int p = parentOf(w);
+            if(p == x)
+                return x;
+            uint64_t pw = word[p].load();
+            int gp = parentOf(pw);
+            if(gp != p) // Path halving, failure only means some other thread changed it already
+                word[x].compare_exchange_weak(w, (w & ~0xffffffffULL) | (uint32_t)gp);
+            x = gp;
+        }
+    }
+
+    void unite(int x, int y){
+        while(true){
+            x = find(x);
+            y = find(y);
+            if(x == y)
+                return;
+            uint64_t wx = word[x].load(), wy = word[y].load();
+            if(parentOf(wx) != x || parentOf(wy) != y)  // Not roots anymore
+                continue;
+            uint32_t rx = rankOf(wx), ry = rankOf(wy);
+            if(rx > ry || (rx == ry && x > y)){  // x should be the smaller one
+                swap(x, y);
+                swap(wx, wy);
+                swap(rx, ry);
+            }
+            if(word[x].compare_exchange_strong(wx, ((uint64_t)rx << 32) | (uint32_t)y) == false)
+                continue;
+            if(rx == ry)    // Height of y may have increased
+                word[y].compare_exchange_strong(wy, ((uint64_t)(ry + 1) << 32) | (uint32_t)y);
+            return;
+        }
+    }
+};
+
+/* Edges are divided equally among the threads, every thread calls unite() for its edges
+label[i] = component of vertex i, components numbered 0, 1, 2... in order of their smallest vertex
+Returns the no. of components (same as islandBFS())
+*/
+int parallelComponents(const vector<pair<int, int>> &edges, int v, vector<int> &label, int threads){
+    ConcurrentDSU dsu(v);
+    vector<thread> pool;
+    size_t per = (edges.size() + threads - 1) / threads;
+    for(int t = 0; t < threads; t++){
+        size_t start = t * per, end = min(edges.size(), start + per);
+        pool.emplace_back([&dsu, &edges, start, end]{
+            for(size_t k = start; k < end; k++)
+                dsu.unite(edges[k].first, edges[k].second);
+        });
+    }
+    for(auto &th : pool)
+        th.join();
+
+    label.assign(v, -1);
+    int count = 0;
+    for(int i = 0; i < v; i++){
+        int root = dsu.find(i);
+        if(label[root] == -1)   // Smallest vertex of the component
+            label[root] = count++;
+        label[i] = label[root];
+    }
+    return count;
+}
+
+// Benchmark - islandBFS() vs parallelComponents(), islandBFS() is also used to check the answer
+void benchComponents(int v, int e, int threads){
+    mt19937 rng(3);
+    vector<pair<int, int>> edges;
+    vector<vector<int>> adjStore(v);
+    vector<int> *adj = adjStore.data();
+    for(int i = 0; i < e; i++){
+        int a = rng() % v, b = rng() % v;
+        addEdge_UD(edges, a, b);
+        addEdge_UD(adj, a, b);
+    }
+
+    auto start = chrono::steady_clock::now();
+    int expected = islandBFS(adj, v);
+    double tBFS = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<int> label;
+    start = chrono::steady_clock::now();
+    int count = parallelComponents(edges, v, label, threads);
+    double tUF = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    bool ok = (count == expected);
+    for(auto &ed : edges)   // Both ends of an edge must be in the same component
+        ok = ok && label[ed.first] == label[ed.second];
+    cout << "islandBFS          : " << tBFS << " s, " << expected << " components" << endl;
+    cout << "parallelComponents : " << tUF << " s, " << count << " components, " << threads << " threads" << endl;
+    cout << "correct            : " << (ok ? "yes" : "no") << endl;
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Shortest path in a weighted graph - Dijkstra's algorithm
+//----------------------------------------------------------------------------------------------------------------------------------------
+// Weighted adjacency list - adj[u] contains {v, weight}, undirected
+void addEdge_W(vector<pair<int, int>> adj[], int u, int v, int w){
+    adj[u].push_back({v, w});
+    adj[v].push_back({u, w});
+}
+
+/* Indexed min heap - same idea as MinHeap in heap.cpp, but stores vertices along with their keys
+    - pos[u] = index of vertex u in the heap array (-1 if not present), updated on every move
+    - so decreaseKey() takes the vertex, not the array index
+d-ary heap - every node has d children instead of 2 (d = 2, 4 or 8)
+    - height = log_d(n), so insert and decreaseKey (move up) are faster
+    - extractMin (move down) compares d children per level, but they are next to each other in memory
+Elements are moved into the "hole" and written once at the end, instead of swapping at every level
+*/
+struct IndexedMinHeap{
+    int d;
+    int size;
+    vector<pair<int, int>> arr; // {key, vertex}, key kept with the vertex so comparisons don't jump to another array
+    vector<int> pos;    // Position of every vertex in arr
+
+    IndexedMinHeap(int n, int arity = 4){
+        d = arity;
+        size = 0;
+        arr.resize(n);
+        pos.assign(n, -1);
+    }
+
+    // Returns first child of the given index, other children follow it
+    int child(int i){
+        return d * i + 1;
+    }
+
+    // Returns parent of the given index
+    int parent(int i){
+        return (i - 1) / d;
+    }
+
+    bool empty(){
+        return size == 0;
+    }
+
+    bool contains(int u){
+        return pos[u] != -1;
+    }
+
+    // Moves the element at index i up till its parent is smaller
+    void siftUp(int i){
+        pair<int, int> x = arr[i];
+        while(i != 0 && arr[parent(i)].first > x.first){
+            arr[i] = arr[parent(i)];
+            pos[arr[i].second] = i;
+            i = parent(i);
+        }
+        arr[i] = x;
+        pos[x.second] = i;
+    }
+
+    // Moves the element at index i down till all its children are greater
+    void siftDown(int i){
+        pair<int, int> x = arr[i];
+        while(true){
+            int first = child(i);
+            if(first >= size)
+                break;
+            int last = min(first + d, size);
+            int minimum = first;
+            for(int c = first + 1; c < last; c++){
+                if(arr[c].first < arr[minimum].first)
+                    minimum = c;
+            }
+            if(arr[minimum].first >= x.first)
+                break;
+            arr[i] = arr[minimum];
+            pos[arr[i].second] = i;
+            i = minimum;
+        }
+        arr[i] = x;
+        pos[x.second] = i;
+    }
+
+    void insert(int u, int k){
+        arr[size] = {k, u};
+        size++;
+        siftUp(size - 1);
+    }
+
+    // Key of u can only be decreased
+    void decreaseKey(int u, int k){
+        arr[pos[u]].first = k;
+        siftUp(pos[u]);
+    }
+
+    // Empties the heap, O(size) instead of O(n), so one heap can be reused for many searches
+    void clear(){
+        for(int i = 0; i < size; i++)
+            pos[arr[i].second] = -1;
+        size = 0;
+    }
+
+    // Removes and returns the vertex with minimum key
+    int extractMin(){
+        int u = arr[0].second;
+        pos[u] = -1;
+        size--;
+        if(size > 0){
+            arr[0] = arr[size];
+            siftDown(0);
+        }
+        return u;
+    }
+};
+
+/* Dijkstra - shortest distance from source to all vertices, weights should be non negative
+Approach - Pick the unfinalised vertex with minimum distance (extractMin), it is final now
+         - Relax its edges: if dist[u] + w < dist[x], decrease the key of x
+Every vertex is in the heap at most once
+Time complexity - O((v + e) * log_d(v))
+*/
+void dijkstra(vector<pair<int, int>> adj[], int v, int source, int dist[], int arity = 4){
+    IndexedMinHeap h(v, arity);
+    for(int i = 0; i < v; i++)
+        dist[i] = INT_MAX;
+    dist[source] = 0;
+    h.insert(source, 0);
+    while(h.empty() == false){
+        int u = h.extractMin();
+        for(auto &e : adj[u]){
+            int x = e.first, w = e.second;
+            if(dist[u] + w < dist[x]){
+                dist[x] = dist[u] + w;
+                if(h.contains(x))
+                    h.decreaseKey(x, dist[x]);
+                else
+                    h.insert(x, dist[x]);
+            }
+        }
+    }
+}
+
+/* Same algorithm with priority_queue, which has no decrease key
+A vertex is pushed again for every improvement, and old entries are skipped when popped (lazy deletion)
+Heap can have up to e entries
+*/
+void dijkstraPQ(vector<pair<int, int>> adj[], int v, int source, int dist[]){
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;   // {distance, vertex}
+    for(int i = 0; i < v; i++)
+        dist[i] = INT_MAX;
+    dist[source] = 0;
+    pq.push({0, source});
+    while(pq.empty() == false){
+        int d = pq.top().first, u = pq.top().second;
+        pq.pop();
+        if(d > dist[u])  // Old entry
+            continue;
+        for(auto &e : adj[u]){
+            int x = e.first, w = e.second;
+            if(d + w < dist[x]){
+                dist[x] = d + w;
+                pq.push({dist[x], x});
+            }
+        }
+    }
+}
+
+// Benchmark - road network like graph: rows x cols grid, random weights 1 to 1000, few random shortcuts
+void benchDijkstra(int rows, int cols, int rounds = 3){
+    int v = rows * cols;
+    mt19937 rng(11);
+    vector<vector<pair<int, int>>> adjStore(v);
+    vector<pair<int, int>> *adj = adjStore.data();
+    for(int r = 0; r < rows; r++){
+        for(int c = 0; c < cols; c++){
+            int u = r * cols + c;
+            if(c + 1 < cols)
+                addEdge_W(adj, u, u + 1, 1 + rng() % 1000);
+            if(r + 1 < rows)
+                addEdge_W(adj, u, u + cols, 1 + rng() % 1000);
+        }
+    }
+    for(int i = 0; i < v / 100; i++)    // Highways
+        addEdge_W(adj, rng() % v, rng() % v, 1000 + rng() % 10000);
+
+    vector<int> expected(v), dist(v);
+    auto timeIt = [&](const char *name, function<void(int)> run){
+        auto start = chrono::steady_clock::now();
+        for(int r = 0; r < rounds; r++)
+            run(r);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count() / rounds;
+        cout << name << " : " << secs << " s" << (dist == expected ? "" : "  WRONG DISTANCES") << endl;
+    };
+    dijkstraPQ(adj, v, 0, expected.data());
+    timeIt("priority_queue (lazy)", [&](int){ dijkstraPQ(adj, v, 0, dist.data()); });
+    for(int d : {2, 4, 8}){
+        string name = "indexed " + to_string(d) + "-ary heap";
+        timeIt(name.c_str(), [&](int){ dijkstra(adj, v, 0, dist.data(), d); });
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Batched BFS - shortest paths from many sources together (multi source BFS)
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Calling shortestPathDist() k times reads every edge k times
+Here up to 64 BFS run together, bit k of a 64 bit word belongs to the k-th source
+    - seen[x]  = sources which have reached x
+    - visit[x] = sources for which x is in the current frontier
+    - one edge (u, x) is read once per level for all the sources: next[x] |= visit[u]
+    - new[x] = next[x] & ~seen[x] gives the sources reaching x for the first time, dist = level
+dist[k * v + x] = distance of x from sources[k], INT16_MAX if not reachable (same as shortestPathDist())
+More than 64 sources are processed in groups of 64, nothing is printed
+Time complexity - O((v + E) * levels) per group instead of O((v + E) * 64)
+*/
+template<class Graph>
+void multiSourceBFS(const Graph &g, const vector<int> &sources, int dist[]){
+    int n = g.v;
+    vector<uint64_t> seen(n), visit(n), next(n);
+    for(size_t i = 0; i < (size_t)n * sources.size(); i++)
+        dist[i] = INT16_MAX;
+
+    for(size_t first = 0; first < sources.size(); first += 64){
+        int count = min<size_t>(64, sources.size() - first);
+        int *d = dist + first * n;  // Rows of this group
+        fill(seen.begin(), seen.end(), 0);
+        fill(visit.begin(), visit.end(), 0);
+        for(int k = 0; k < count; k++){
+            int s = sources[first + k];
+            seen[s] |= 1ULL << k;
+            visit[s] |= 1ULL << k;
+            d[(size_t)k * n + s] = 0;
+        }
+
+        bool active = true;
+        for(int level = 1; active; level++){
+            fill(next.begin(), next.end(), 0);
+            for(int u = 0; u < n; u++){
+                if(visit[u] == 0)
+                    continue;
+                for(int i = g.offset[u]; i < g.offset[u + 1]; i++)
+                    next[g.nbr[i]] |= visit[u];
+            }
+            active = false;
+            for(int x = 0; x < n; x++){
+                uint64_t reached = next[x] & ~seen[x];
+                visit[x] = reached;
+                if(reached == 0)
+                    continue;
+                active = true;
+                seen[x] |= reached;
+                for(; reached != 0; reached &= reached - 1)
+                    d[(size_t)__builtin_ctzll(reached) * n + x] = level;
+            }
+        }
+    }
+}
+
+// Benchmark - shortestPathDist() in a loop vs multiSourceBFS() for the same sources
+void benchMultiSourceBFS(int v, int e, int count){
+    mt19937 rng(5);
+    vector<pair<int, int>> edges;
+    for(int i = 0; i < e; i++)
+        addEdge_UD(edges, rng() % v, rng() % v);
+    CSRGraph g = buildCSR(edges, v);
+    vector<int> sources(count);
+    for(int &s : sources)
+        s = rng() % v;
+
+    vector<int> expected((size_t)v * count), dist((size_t)v * count);
+    auto start = chrono::steady_clock::now();
+    for(int k = 0; k < count; k++)
+        shortestPathDist(g, sources[k], expected.data() + (size_t)k * v);
+    double tLoop = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    multiSourceBFS(g, sources, dist.data());
+    double tBatch = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "shortestPathDist loop : " << tLoop << " s" << endl;
+    cout << "multiSourceBFS        : " << tBatch << " s, " << tLoop / tBatch << "x" << endl;
+    cout << "same distances        : " << (dist == expected ? "yes" : "no") << endl;
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Binary graph file - CSR saved to disk
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Building a graph edge by edge (or parsing a text edge list) is slow for big graphs
+File layout
+    - header (32 bytes) - magic "CSRG", version, flags, v, no. of stored edges
+    - plain format - offset[0..v] and nbr[0..E-1] as 32 bit ints, exactly the CSRGraph arrays
+    - compressed format (flags = 1) - for every vertex: degree, then neighbours as differences from the previous
+      neighbour (zigzag so negative differences stay small), all written as varints (7 bits per byte)
+Plain file can be memory mapped and used directly, no parsing and no copying
+Compressed file is smaller but has to be decoded into a CSRGraph
+*/
+struct GraphFileHeader{
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    int32_t v;
+    int64_t edges;
+    int64_t reserved;
+};
+
+const uint32_t GRAPH_FILE_COMPRESSED = 1;
+
+// Varint - 7 bits of the value per byte, high bit = 1 if more bytes follow
+void writeVarint(vector<uint8_t> &out, uint64_t x){
+    while(x >= 128){
+        out.push_back((uint8_t)(x | 128));
+        x >>= 7;
+    }
+    out.push_back((uint8_t)x);
+}
+
+uint64_t readVarint(const uint8_t *&p){
+    uint64_t x = 0;
+    for(int shift = 0; ; shift += 7){
+        uint8_t b = *p++;
+        if(shift < 64)  // Bits past 64 can only come from a damaged file, they are dropped
+            x |= (uint64_t)(b & 127) << shift;
+        if(b < 128)
+            return x;
+    }
+}
+
+// Returns false if the file could not be written
+bool writeGraph(const CSRGraph &g, const string &path, bool compress = false){
+    FILE *f = fopen(path.c_str(), "wb");
+    if(f == NULL)
+        return false;
+    GraphFileHeader h = {{'C', 'S', 'R', 'G'}, 1, compress ? GRAPH_FILE_COMPRESSED : 0, g.v, g.offset[g.v], 0};
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    if(compress == false){
+        ok = ok && fwrite(g.offset.data(), sizeof(int), g.v + 1, f) == (size_t)g.v + 1;
+        ok = ok && fwrite(g.nbr.data(), sizeof(int), g.nbr.size(), f) == g.nbr.size();
+    }
+    else{
+        vector<uint8_t> out;
+        for(int u = 0; u < g.v; u++){
+            writeVarint(out, g.degree(u));
+            int prev = u;   // First neighbour is stored relative to u
+            for(int i = g.offset[u]; i < g.offset[u + 1]; i++){
+                int64_t diff = (int64_t)g.nbr[i] - prev;
+                writeVarint(out, ((uint64_t)diff << 1) ^ (uint64_t)(diff >> 63));  // Zigzag
+                prev = g.nbr[i];
+            }
+        }
+        ok = ok && fwrite(out.data(), 1, out.size(), f) == out.size();
+    }
+    return (fclose(f) == 0) && ok;
+}
+
+// Header must have the magic, v >= 0 and 0 <= edges <= INT_MAX (offsets are int)
+bool validHeader(const GraphFileHeader &h){
+    return memcmp(h.magic, "CSRG", 4) == 0 && h.v >= 0 && h.edges >= 0 && h.edges <= INT_MAX;
+}
+
+// offset must start at 0, never decrease and end at edges, else degree() is negative or nbr[] is read past the end
+bool validOffsets(const int *offset, int v, int64_t edges){
+    if(offset[0] != 0 || offset[v] != edges)
+        return false;
+    for(int u = 0; u < v; u++){
+        if(offset[u] > offset[u + 1])
+            return false;
+    }
+    return true;
+}
+
+// Every neighbour must be a vertex, traversals use it as an index into visited[] / offset[]
+bool validNeighbours(const int *nbr, int v, int64_t edges){
+    for(int64_t i = 0; i < edges; i++){
+        if(nbr[i] < 0 || nbr[i] >= v)
+            return false;
+    }
+    return true;
+}
+
+/* Memory mapped graph - offset and nbr point directly into the mapped file
+Pages are loaded by the OS when first touched, so opening only reads the offsets (O(v) check), not the edges
+checkNeighbours = true also checks every neighbour id (O(E), reads the whole file) - use it for files that are not trusted
+Only plain (not compressed) files can be mapped
+*/
+struct MappedGraph{
+    int v = 0;
+    const int *offset = NULL;
+    const int *nbr = NULL;
+    void *base = MAP_FAILED;
+    size_t length = 0;
+
+    MappedGraph(){}
+    MappedGraph(const MappedGraph &) = delete;
+    MappedGraph &operator=(const MappedGraph &) = delete;
+
+    ~MappedGraph(){
+        close();
+    }
+
+    int degree(int u) const{
+        return offset[u + 1] - offset[u];
+    }
+
+    // Returns false if the file is missing, not a graph file, damaged or compressed
+    bool open(const string &path, bool checkNeighbours = false){
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            return false;
+        struct stat st;
+        if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GraphFileHeader)){
+            ::close(fd);
+            return false;
+        }
+        length = st.st_size;
+        base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);    // Mapping stays valid after closing the file
+        if(base == MAP_FAILED)
+            return false;
+
+        const GraphFileHeader *h = (const GraphFileHeader *)base;
+        if(validHeader(*h) == false || h->flags != 0 ||
+           length < sizeof(GraphFileHeader) + sizeof(int) * ((size_t)h->v + 1 + h->edges)){
+            close();
+            return false;
+        }
+        const int *off = (const int *)(h + 1);
+        if(validOffsets(off, h->v, h->edges) == false ||
+           (checkNeighbours && validNeighbours(off + h->v + 1, h->v, h->edges) == false)){
+            close();
+            return false;
+        }
+        v = h->v;
+        offset = off;
+        nbr = offset + v + 1;
+        return true;
+    }
+
+    void close(){
+        if(base != MAP_FAILED)
+            munmap(base, length);
+        base = MAP_FAILED;
+        v = 0;
+        offset = nbr = NULL;
+    }
+};
+
+// Reads both plain and compressed files into a CSRGraph, returns false on a bad file
+bool readGraph(const string &path, CSRGraph &g){
+    FILE *f = fopen(path.c_str(), "rb");
+    if(f == NULL)
+        return false;
+    GraphFileHeader h;
+    bool ok = fread(&h, sizeof(h), 1, f) == 1 && validHeader(h);
+    if(ok){
+        // File must be big enough for v and edges before allocating for them (at least 1 byte per vertex / edge when compressed)
+        long here = ftell(f);
+        ok = fseek(f, 0, SEEK_END) == 0;
+        uint64_t rest = ok ? (uint64_t)(ftell(f) - here) : 0;
+        ok = ok && fseek(f, here, SEEK_SET) == 0;
+        uint64_t need = (h.flags == 0) ? sizeof(int) * ((uint64_t)h.v + 1 + h.edges) : (uint64_t)h.v + h.edges;
+        ok = ok && rest >= need;
+    }
+    if(ok){
+        g = CSRGraph(h.v);
+        g.nbr.resize(h.edges);
+        if(h.flags == 0){
+            ok = fread(g.offset.data(), sizeof(int), h.v + 1, f) == (size_t)h.v + 1;
+            ok = ok && fread(g.nbr.data(), sizeof(int), h.edges, f) == (size_t)h.edges;
+            ok = ok && validOffsets(g.offset.data(), h.v, h.edges) && validNeighbours(g.nbr.data(), h.v, h.edges);
+        }
+        else{
+            vector<uint8_t> in;
+            uint8_t buf[1 << 16];
+            for(size_t got; (got = fread(buf, 1, sizeof(buf), f)) > 0; )
+                in.insert(in.end(), buf, buf + got);
+            // Zero padding - a varint that starts before end stops inside the padding at the latest
+            // p <= end is checked after every varint, so the next one never starts in the padding
+            in.resize(in.size() + 10, 0);
+            const uint8_t *p = in.data(), *end = in.data() + in.size() - 10;
+            int k = 0;
+            for(int u = 0; u < h.v && ok; u++){
+                uint64_t deg = readVarint(p);
+                g.offset[u] = k;
+                ok = (p <= end) && deg <= (uint64_t)(h.edges - k);
+                int64_t prev = u;
+                for(uint64_t i = 0; i < deg && ok; i++){
+                    uint64_t z = readVarint(p);
+                    prev = (int64_t)((uint64_t)prev + ((z >> 1) ^ -(z & 1)));   // Unsigned add, a damaged value cannot overflow
+                    ok = (p <= end) && prev >= 0 && prev < h.v;
+                    g.nbr[k++] = (int)prev;
+                }
+            }
+            g.offset[h.v] = k;
+            ok = ok && k == h.edges;
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+/* Benchmark - loading a graph from a text edge list ("u v" per line, read through addEdge_UD)
+vs reading the compressed file vs memory mapping the plain file (time includes one BFS,
+so that the mapped pages are really read)
+*/
+void benchGraphLoad(int v, int e, const string &dir = "/tmp"){
+    mt19937 rng(9);
+    vector<pair<int, int>> edges;
+    for(int i = 0; i < e; i++)
+        addEdge_UD(edges, rng() % v, rng() % v);
+    CSRGraph g = buildCSR(edges, v);
+    string text = dir + "/graph.txt", plain = dir + "/graph.csr", packed = dir + "/graph.csrz";
+    {
+        ofstream out(text);
+        out << v << " " << e << "\n";
+        for(auto &ed : edges)
+            out << ed.first << " " << ed.second << "\n";
+    }
+    writeGraph(g, plain);
+    writeGraph(g, packed, true);
+    vector<int> expected(v), dist(v);
+    shortestPathDist(g, 0, expected.data());
+
+    auto start = chrono::steady_clock::now();
+    {
+        ifstream in(text);
+        int n, m;
+        in >> n >> m;
+        vector<vector<int>> adjStore(n);
+        for(int i = 0, a, b; i < m && in >> a >> b; i++)
+            addEdge_UD(adjStore.data(), a, b);
+        shortestPathDist(adjStore.data(), n, 0, dist.data());
+    }
+    double tText = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    bool ok = dist == expected;
+
+    start = chrono::steady_clock::now();
+    CSRGraph loaded(0);
+    ok = ok && readGraph(packed, loaded);
+    shortestPathDist(loaded, 0, dist.data());
+    double tPacked = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ok = ok && dist == expected;
+
+    start = chrono::steady_clock::now();
+    MappedGraph mg;
+    ok = ok && mg.open(plain);
+    shortestPathDist(mg, 0, dist.data());
+    double tMapped = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ok = ok && dist == expected;
+
+    // Damaged files - cut short, or with random bytes changed after the header
+    // Cut files must be rejected, changed files may load but only as a valid graph
+    bool safe = true;
+    for(const string &path : { plain, packed }){
+        ifstream in(path, ios::binary);
+        string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        string bad = dir + "/graph.bad";
+        for(int trial = 0; trial < 20; trial++){
+            string cut = bytes;
+            if(trial < 4)
+                cut.resize(min(cut.size() - 1, (size_t)(trial == 0 ? 40 : trial == 1 ? 100 : trial == 2 ? 1000 : cut.size() / 2)));
+            else{
+                for(int j = 0; j < 8; j++)
+                    cut[sizeof(GraphFileHeader) + rng() % (cut.size() - sizeof(GraphFileHeader))] = (char)rng();
+            }
+            ofstream(bad, ios::binary).write(cut.data(), cut.size());
+            CSRGraph dg(0);
+            bool read = readGraph(bad, dg);
+            MappedGraph dm;
+            bool mapped = dm.open(bad, true);
+            if(trial < 4)
+                safe = safe && read == false && mapped == false;
+            else if(read)
+                safe = safe && validOffsets(dg.offset.data(), dg.v, dg.nbr.size()) && validNeighbours(dg.nbr.data(), dg.v, dg.nbr.size());
+        }
+        remove(bad.c_str());
+    }
+
+    cout << "text edge list  : " << tText << " s" << endl;
+    cout << "compressed file : " << tPacked << " s" << endl;
+    cout << "mmap plain file : " << tMapped << " s" << endl;
+    cout << "same distances  : " << (ok ? "yes" : "no") << endl;
+    cout << "damaged files   : " << (safe ? "rejected" : "NOT rejected") << endl;
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Bidirectional BFS - shortest path between two given vertices
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* shortestPath() finds distance to every vertex even if only one target is needed
+Here BFS runs from s (forward) and from t (backward) together
+    - every step expands one full level of the side whose frontier has fewer edges
+    - when a vertex reached by one side is already reached by the other, a path is found
+    - the level is completed and the shortest meeting is taken, then search stops
+If both searches go d/2 levels instead of one going d levels, far fewer vertices are visited
+radj = reverse adjacency list (for directed graph), pass adj itself for undirected graph
+Per vertex data is stamped with the query no., so nothing of size v is cleared per query
+Returns no. of edges on the shortest path (-1 if t is not reachable), path gets s ... t if given
+*/
+int bidirectionalBFS(vector<int> adj[], vector<int> radj[], int v, int s, int t, vector<int> *path = NULL){
+    static thread_local vector<int> stampF, stampB, distF, distB, parF, parB;
+    static thread_local int query = 0;
+    if((int)stampF.size() < v){
+        for(auto *a : {&stampF, &stampB, &distF, &distB, &parF, &parB})
+            a->assign(v, 0);
+        query = 0;
+    }
+    query++;
+    if(path != NULL)
+        path->clear();
+
+    stampF[s] = query;
+    distF[s] = 0;
+    parF[s] = -1;
+    stampB[t] = query;
+    distB[t] = 0;
+    parB[t] = -1;
+    vector<int> frontF{s}, frontB{t}, next;
+    long long edgesF = adj[s].size(), edgesB = radj[t].size();
+    int best = (s == t) ? 0 : INT_MAX, meet = s;
+
+    while(best == INT_MAX && frontF.empty() == false && frontB.empty() == false){
+        bool forward = edgesF <= edgesB;
+        vector<int> *g = forward ? adj : radj;
+        vector<int> &front = forward ? frontF : frontB;
+        vector<int> &stampMine = forward ? stampF : stampB, &stampOther = forward ? stampB : stampF;
+        vector<int> &distMine = forward ? distF : distB, &distOther = forward ? distB : distF;
+        vector<int> &parMine = forward ? parF : parB;
+        long long edges = 0;
+        next.clear();
+        for(int u : front){
+            for(int x : g[u]){
+                if(stampMine[x] == query)
+                    continue;
+                stampMine[x] = query;
+                distMine[x] = distMine[u] + 1;
+                parMine[x] = u;
+                next.push_back(x);
+                edges += g[x].size();
+                if(stampOther[x] == query && distMine[x] + distOther[x] < best){
+                    best = distMine[x] + distOther[x];
+                    meet = x;
+                }
+            }
+        }
+        front.swap(next);
+        (forward ? edgesF : edgesB) = edges;
+    }
+    if(best == INT_MAX)
+        return -1;
+
+    if(path != NULL){
+        for(int x = meet; x != -1; x = parF[x])    // meet back to s
+            path->push_back(x);
+        reverse(path->begin(), path->end());
+        for(int x = parB[meet]; x != -1; x = parB[x])  // after meet till t
+            path->push_back(x);
+    }
+    return best;
+}
+
+// For undirected graph
+int bidirectionalBFS(vector<int> adj[], int v, int s, int t, vector<int> *path = NULL){
+    return bidirectionalBFS(adj, adj, v, s, t, path);
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Vertex reordering for cache locality
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Vertex ids come in whatever order the input gives, so neighbours of a vertex are scattered in memory
+and every dist[x] / visited[x] access is a cache miss
+Relabeling - give new ids such that vertices used together get nearby ids
+    - newId[old] = new id of a vertex, oldId[new] = original id (to map results back)
+Orders
+    - degree  - high degree vertices first, the most accessed entries share cache lines
+    - BFS     - vertices in BFS order, a frontier occupies a continuous range
+    - RCM     - reverse Cuthill McKee, BFS from a low degree vertex visiting neighbours by increasing degree,
+                then reversed, keeps edges close to the diagonal (small bandwidth)
+    - Gorder  - greedy, next vertex = one sharing most edges and common neighbours with the last w placed vertices
+*/
+struct Reordering{
+    vector<int> newId;
+    vector<int> oldId;
+};
+
+// Fills newId from the list of old ids in their new order
+Reordering makeReordering(const vector<int> &order){
+    Reordering r;
+    r.oldId = order;
+    r.newId.resize(order.size());
+    for(int i = 0; i < (int)order.size(); i++)
+        r.newId[order[i]] = i;
+    return r;
+}
+
+Reordering degreeOrder(const CSRGraph &g){
+    vector<int> order(g.v);
+    for(int i = 0; i < g.v; i++)
+        order[i] = i;
+    stable_sort(order.begin(), order.end(), [&](int a, int b){ return g.degree(a) > g.degree(b); });
+    return makeReordering(order);
+}
+
+// BFS order, rcm = true gives reverse Cuthill McKee
+Reordering bfsOrder(const CSRGraph &g, bool rcm = false){
+    vector<int> order;
+    order.reserve(g.v);
+    VisitedSet visited(g.v);
+    vector<int> starts(g.v);
+    for(int i = 0; i < g.v; i++)
+        starts[i] = i;
+    if(rcm) // Every component starts from its lowest degree vertex
+        stable_sort(starts.begin(), starts.end(), [&](int a, int b){ return g.degree(a) < g.degree(b); });
+    vector<int> nbrs;
+    for(int s : starts){
+        if(visited.test(s))
+            continue;
+        visited.set(s);
+        size_t head = order.size();
+        order.push_back(s);
+        while(head < order.size()){ // order itself works as the queue
+            int u = order[head++];
+            nbrs.assign(g.nbr.begin() + g.offset[u], g.nbr.begin() + g.offset[u + 1]);
+            if(rcm)
+                sort(nbrs.begin(), nbrs.end(), [&](int a, int b){ return g.degree(a) < g.degree(b); });
+            for(int x : nbrs){
+                if(visited.test(x) == false){
+                    visited.set(x);
+                    order.push_back(x);
+                }
+            }
+        }
+    }
+    if(rcm)
+        reverse(order.begin(), order.end());
+    return makeReordering(order);
+}
+
+/* Gorder style greedy ordering, window of w vertices
+score[x] = no. of edges + common neighbours between x and the vertices in the window
+    - when u enters the window, score of its neighbours and their neighbours increases by 1, decreases when it leaves
+    - neighbours of very high degree vertices are skipped for common neighbours (hubs would touch the whole graph)
+    - next vertex = unplaced vertex with max score (lazy max heap, outdated entries skipped),
+      if no vertex has score > 0 the highest degree unplaced vertex is taken
+For undirected graph, in-neighbours = neighbours
+Time complexity - O(sum of degree^2 * log v) worst case, limited by hubLimit
+*/
+Reordering gorderOrder(const CSRGraph &g, int w = 5, int hubLimit = 32){
+    int n = g.v;
+    vector<int> score(n, 0), order;
+    order.reserve(n);
+    vector<bool> placed(n, false);
+    priority_queue<pair<int, int>> pq;  // {score, vertex}
+    vector<int> byDegree = degreeOrder(g).oldId;
+    int nextHub = 0;
+
+    auto update = [&](int u, int delta){
+        for(int i = g.offset[u]; i < g.offset[u + 1]; i++){
+            int x = g.nbr[i];
+            if(placed[x] == false){
+                score[x] += delta;
+                pq.push({score[x], x});
+            }
+            if(g.degree(x) > hubLimit)
+                continue;
+            for(int j = g.offset[x]; j < g.offset[x + 1]; j++){  // Common neighbour x
+                int y = g.nbr[j];
+                if(placed[y] == false && y != u){
+                    score[y] += delta;
+                    pq.push({score[y], y});
+                }
+            }
+        }
+    };
+
+    for(int k = 0; k < n; k++){
+        int u = -1;
+        while(pq.empty() == false){
+            auto top = pq.top();
+            pq.pop();
+            if(placed[top.second] == false && top.first == score[top.second] && top.first > 0){
+                u = top.second;
+                break;
+            }
+        }
+        if(u == -1){
+            while(placed[byDegree[nextHub]])
+                nextHub++;
+            u = byDegree[nextHub];
+        }
+        placed[u] = true;
+        order.push_back(u);
+        update(u, 1);
+        if(k >= w)
+            update(order[k - w], -1);   // Leaves the window
+    }
+    return makeReordering(order);
+}
+
+// Builds the relabeled graph, neighbour lists are sorted by new id
+CSRGraph relabel(const CSRGraph &g, const Reordering &r){
+    CSRGraph h(g.v);
+    for(int i = 0; i < g.v; i++)
+        h.offset[i + 1] = h.offset[i] + g.degree(r.oldId[i]);
+    h.nbr.resize(h.offset[g.v]);
+    for(int i = 0; i < g.v; i++){
+        int u = r.oldId[i], k = h.offset[i];
+        for(int j = g.offset[u]; j < g.offset[u + 1]; j++)
+            h.nbr[k++] = r.newId[g.nbr[j]];
+        sort(h.nbr.begin() + h.offset[i], h.nbr.begin() + h.offset[i + 1]);
+    }
+    return h;
+}
+
+/* Benchmark - R-MAT graph with randomly shuffled ids (no locality), then every ordering
+Times BFS (shortestPathDist), direction optimizing BFS and DFS (islandDFS on an adjacency list of the same graph)
+Distances are mapped back with newId and checked against the original graph
+*/
+void benchReordering(int scale, int edgeFactor = 16, int rounds = 5){
+    int v = 1 << scale;
+    vector<pair<int, int>> edges = rmatEdges(scale, edgeFactor);
+    vector<int> shuffled(v);
+    for(int i = 0; i < v; i++)
+        shuffled[i] = i;
+    shuffle(shuffled.begin(), shuffled.end(), mt19937(17));
+    for(auto &e : edges)
+        e = {shuffled[e.first], shuffled[e.second]};
+    CSRGraph g = buildCSR(edges, v);
+    int source = 0;
+    for(int i = 0; i < v; i++){
+        if(g.degree(i) > g.degree(source))
+            source = i;
+    }
+    vector<int> expected(v), dist(v);
+    shortestPathDist(g, source, expected.data());
+
+    auto seconds = [](chrono::steady_clock::time_point start){
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    auto run = [&](const char *name, const CSRGraph &h, const Reordering *r){
+        int s = r ? r->newId[source] : source;
+        vector<vector<int>> adjStore(v);
+        for(int u = 0; u < v; u++)
+            adjStore[u].assign(h.nbr.begin() + h.offset[u], h.nbr.begin() + h.offset[u + 1]);
+        double tBFS = 0, tHybrid = 0, tDFS = 0;
+        bool ok = true;
+        for(int k = 0; k < rounds; k++){
+            auto start = chrono::steady_clock::now();
+            shortestPathDist(h, s, dist.data());
+            tBFS += seconds(start);
+            for(int x = 0; x < v && ok; x++)
+                ok = dist[r ? r->newId[x] : x] == expected[x];
+            start = chrono::steady_clock::now();
+            hybridBFS(h, s, dist.data());
+            tHybrid += seconds(start);
+            start = chrono::steady_clock::now();
+            islandDFS(adjStore.data(), v);
+            tDFS += seconds(start);
+        }
+        cout << name << " : BFS " << tBFS / rounds << " s, hybrid BFS " << tHybrid / rounds
+             << " s, DFS " << tDFS / rounds << " s" << (ok ? "" : "  WRONG DISTANCES") << endl;
+    };
+    run("original", g, NULL);
+    Reordering orders[4] = {degreeOrder(g), bfsOrder(g), bfsOrder(g, true), gorderOrder(g)};
+    const char *names[4] = {"degree  ", "BFS     ", "RCM     ", "Gorder  "};
+    for(int k = 0; k < 4; k++)
+        run(names[k], relabel(g, orders[k]), &orders[k]);
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Dynamic graph - edges added and removed one at a time
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* islandBFS(), Ucycle() and Dcycle() start from scratch every time - O(v + e) per update
+Here the answers are kept up to date on every change
+Connected components (edge direction ignored)
+    - union find over the edges, adding an edge = unite(), components decrease when the roots differ
+    - union find cannot split, so removing an edge only marks it outdated,
+      it is rebuilt from the remaining edges at the next components() call
+Cycle detection for directed edges - incremental topological order (Pearce Kelly)
+    - ord[u] = position of u in a topological order of the current graph
+    - new edge u -> x with ord[u] < ord[x] keeps the order valid, nothing to do
+    - otherwise only vertices with ord between ord[x] and ord[u] can be affected:
+      forward DFS from x (ord <= ord[u]) - if it reaches u, the edge closes a cycle
+      backward DFS from u (ord >= ord[x]) - these vertices must come before the forward ones,
+      so the positions used by both sets are given again, backward set first
+    - removing an edge never creates a cycle and keeps the order valid
+addEdge() refuses an edge that would close a cycle, so the graph is always a DAG
+*/
+struct DynamicGraph{
+    int v;
+    vector<vector<int>> out, in;
+    vector<int> ord, vertexAt;  // vertexAt[ord[u]] = u
+    ConcurrentDSU dsu;
+    int count;
+    bool dsuOutdated = false;
+    VisitedSet visited;
+    vector<int> forwardSet, backwardSet, st;
+
+    DynamicGraph(int n) : dsu(n){
+        v = n;
+        count = n;
+        out.resize(n);
+        in.resize(n);
+        ord.resize(n);
+        vertexAt.resize(n);
+        for(int i = 0; i < n; i++)
+            ord[i] = vertexAt[i] = i;
+    }
+
+    // Collects vertices reachable from s through g, staying inside ord range [lo, hi]
+    // Returns true if target is reached
+    bool collect(const vector<vector<int>> &g, int s, int lo, int hi, int target, vector<int> &found){
+        found.clear();
+        st.clear();
+        st.push_back(s);
+        visited.set(s);
+        while(st.empty() == false){
+            int u = st.back();
+            st.pop_back();
+            found.push_back(u);
+            for(int x : g[u]){
+                if(x == target)
+                    return true;
+                if(visited.test(x) == false && ord[x] >= lo && ord[x] <= hi){
+                    visited.set(x);
+                    st.push_back(x);
+                }
+            }
+        }
+        return false;
+    }
+
+    // Adds directed edge u -> x, returns false (and does not add it) if it would form a cycle
+    bool addEdge(int u, int x){
+        if(u == x)
+            return false;
+        if(ord[u] > ord[x]){
+            int lo = ord[x], hi = ord[u];
+            visited.clear(v);
+            if(collect(out, x, lo, hi, u, forwardSet) == true)
+                return false;
+            collect(in, u, lo, hi, -1, backwardSet);
+            auto byOrd = [&](int a, int b){ return ord[a] < ord[b]; };
+            sort(forwardSet.begin(), forwardSet.end(), byOrd);
+            sort(backwardSet.begin(), backwardSet.end(), byOrd);
+            vector<int> slots;  // Positions used by both sets, in increasing order
+            for(int y : backwardSet)
+                slots.push_back(ord[y]);
+            for(int y : forwardSet)
+                slots.push_back(ord[y]);
+            sort(slots.begin(), slots.end());
+            int k = 0;
+            for(int y : backwardSet){
+                ord[y] = slots[k++];
+                vertexAt[ord[y]] = y;
+            }
+            for(int y : forwardSet){
+                ord[y] = slots[k++];
+                vertexAt[ord[y]] = y;
+            }
+        }
+        out[u].push_back(x);
+        in[x].push_back(u);
+        if(dsuOutdated == false && dsu.find(u) != dsu.find(x)){
+            dsu.unite(u, x);
+            count--;
+        }
+        return true;
+    }
+
+    // Removes one u -> x edge, returns false if there is no such edge
+    bool removeEdge(int u, int x){
+        auto it = find(out[u].begin(), out[u].end(), x);
+        if(it == out[u].end())
+            return false;
+        *it = out[u].back();    // Order of neighbours doesn't matter, swap with last and remove
+        out[u].pop_back();
+        auto jt = find(in[x].begin(), in[x].end(), u);
+        *jt = in[x].back();
+        in[x].pop_back();
+        dsuOutdated = true;
+        return true;
+    }
+
+    // No. of connected components, ignoring direction (same as islandBFS() on the undirected version)
+    int components(){
+        if(dsuOutdated){
+            dsu = ConcurrentDSU(v);
+            count = v;
+            for(int u = 0; u < v; u++){
+                for(int x : out[u]){
+                    if(dsu.find(u) != dsu.find(x)){
+                        dsu.unite(u, x);
+                        count--;
+                    }
+                }
+            }
+            dsuOutdated = false;
+        }
+        return count;
+    }
+
+    // Current topological order of all the vertices
+    vector<int> topologicalOrder(){
+        return vertexAt;
+    }
+};
+
+// Benchmark - random edge inserts and deletes with DynamicGraph vs calling Dcycle() and islandBFS() after every update
+// Every 4th update removes a random edge that is present, so removeEdge() and the rebuild in components() are checked too
+void benchDynamicGraph(int v, int updates){
+    mt19937 rng(13);
+    DynamicGraph dg(v);
+    vector<vector<int>> adjStore(v), undirected(v);
+    vector<pair<int, int>> present;  // Edges added and not removed yet
+    int rejected = 0, removed = 0;
+    bool ok = true;
+    double tDynamic = 0, tFull = 0;
+    auto eraseOne = [](vector<int> &list, int x){
+        auto it = find(list.begin(), list.end(), x);
+        *it = list.back();
+        list.pop_back();
+    };
+    for(int k = 0; k < updates; k++){
+        if(k % 4 == 3 && present.empty() == false){
+            int pick = rng() % present.size();
+            int u = present[pick].first, x = present[pick].second;
+            present[pick] = present.back();
+            present.pop_back();
+            auto start = chrono::steady_clock::now();
+            bool gone = dg.removeEdge(u, x);
+            int comps = dg.components();
+            tDynamic += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            start = chrono::steady_clock::now();
+            eraseOne(adjStore[u], x);
+            eraseOne(undirected[u], x);
+            eraseOne(undirected[x], u);
+            int expected = islandBFS(undirected.data(), v);
+            tFull += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            removed++;
+            ok = ok && gone && comps == expected;
+            continue;
+        }
+        int u = rng() % v, x = rng() % v;
+        auto start = chrono::steady_clock::now();
+        bool added = dg.addEdge(u, x);
+        int comps = dg.components();
+        tDynamic += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();    // Same check from scratch
+        adjStore[u].push_back(x);
+        bool cycle = Dcycle(adjStore.data(), v);
+        if(cycle)
+            adjStore[u].pop_back();
+        else{
+            addEdge_UD(undirected.data(), u, x);
+            present.push_back({u, x});
+        }
+        int expected = islandBFS(undirected.data(), v);
+        tFull += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        rejected += !added;
+        ok = ok && added == !cycle && comps == expected;
+    }
+    // Order kept by DynamicGraph must still be a topological order of the remaining edges
+    vector<int> order = dg.topologicalOrder(), pos(v);
+    for(int i = 0; i < v; i++)
+        pos[order[i]] = i;
+    for(auto &e : present)
+        ok = ok && pos[e.first] < pos[e.second];
+    cout << "DynamicGraph      : " << tDynamic << " s" << endl;
+    cout << "Dcycle + islandBFS: " << tFull << " s" << endl;
+    cout << "rejected edges    : " << rejected << ", removed edges: " << removed << ", same answers: " << (ok ? "yes" : "no") << endl;
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Sorted neighbour lists, set intersection and triangle counting
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* addEdge_UD() appends neighbours in input order, so finding common neighbours of u and x needs hashing
+If every neighbour list is sorted, common neighbours = intersection of two sorted arrays (merge like step)
+Sorting also removes repeated edges and self loops, as triangles need simple graph
+*/
+void sortNeighbours(vector<int> adj[], int v){
+    for(int u = 0; u < v; u++){
+        sort(adj[u].begin(), adj[u].end());
+        adj[u].erase(unique(adj[u].begin(), adj[u].end()), adj[u].end());
+        adj[u].erase(remove(adj[u].begin(), adj[u].end(), u), adj[u].end());
+    }
+}
+
+void sortNeighbours(CSRGraph &g){
+    int k = 0;
+    for(int u = 0; u < g.v; u++){
+        int first = k;
+        sort(g.nbr.begin() + g.offset[u], g.nbr.begin() + g.offset[u + 1]);
+        for(int i = g.offset[u]; i < g.offset[u + 1]; i++){
+            if(g.nbr[i] != u && (k == first || g.nbr[k - 1] != g.nbr[i]))
+                g.nbr[k++] = g.nbr[i];  // Compacting in place, k <= i always
+        }
+        g.offset[u] = first;
+    }
+    g.offset[g.v] = k;
+    g.nbr.resize(k);
+}
+
+/* No. of common elements of two sorted arrays without repeated elements
+Scalar - merge step, move the pointer of the smaller element
+SIMD - compare a block of a with a block of b, all pairs at once:
+    - b block is rotated and compared with a block (4 rotations for SSE, 8 for AVX2), matches are OR'ed
+    - no. of set bits = common elements in these blocks
+    - the block with the smaller last element is finished, move past it
+Compile with -mavx2 (or -march=native) for the AVX2 version, SSE2 is always there on x86-64
+*/
+int intersectCountScalar(const int *a, int na, const int *b, int nb){
+    int i = 0, j = 0, count = 0;
+    while(i < na && j < nb){
+        if(a[i] < b[j])
+            i++;
+        else if(a[i] > b[j])
+            j++;
+        else{
+            count++;
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+int intersectCount(const int *a, int na, const int *b, int nb){
+    int i = 0, j = 0, count = 0;
+#if defined(__AVX2__)
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    while(i + 8 <= na && j + 8 <= nb){
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + j));
+        __m256i match = _mm256_cmpeq_epi32(va, vb);
+        for(int r = 1; r < 8; r++){
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            match = _mm256_or_si256(match, _mm256_cmpeq_epi32(va, vb));
+        }
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(match)));
+        int lastA = a[i + 7], lastB = b[j + 7];
+        if(lastA <= lastB)
+            i += 8;
+        if(lastB <= lastA)
+            j += 8;
+    }
+#elif defined(__SSE2__)
+    while(i + 4 <= na && j + 4 <= nb){
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+        __m128i match = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(match)));
+        int lastA = a[i + 3], lastB = b[j + 3];
+        if(lastA <= lastB)
+            i += 4;
+        if(lastB <= lastA)
+            j += 4;
+    }
+#endif
+    return count + intersectCountScalar(a + i, na - i, b + j, nb - j);  // Remaining elements
+}
+
+// Runs work(u) for all the vertices, vertices shared among the threads in chunks (next chunk = atomic counter)
+void parallelForVertices(int v, int threads, function<void(int, int)> work){
+    const int CHUNK = 256;
+    atomic<int> next(0);
+    auto worker = [&](int t){
+        for(int start = next.fetch_add(CHUNK); start < v; start = next.fetch_add(CHUNK)){
+            for(int u = start; u < min(v, start + CHUNK); u++)
+                work(t, u);
+        }
+    };
+    vector<thread> pool;
+    for(int t = 1; t < threads; t++)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for(auto &th : pool)
+        th.join();
+}
+
+/* Triangle counting - g must be sorted with sortNeighbours()
+Every triangle u < x < w is counted once: for every edge u - x with x > u,
+common neighbours of u and x that are greater than x
+Sorted list, so neighbours greater than x are a suffix of the list (upper_bound)
+Time complexity - O(sum over edges of min degree) approximately
+*/
+long long countTriangles(const CSRGraph &g, int threads = 1){
+    vector<long long> partial(threads, 0);
+    parallelForVertices(g.v, threads, [&](int t, int u){
+        const int *nu = g.nbr.data() + g.offset[u], *nuEnd = g.nbr.data() + g.offset[u + 1];
+        for(const int *p = upper_bound(nu, nuEnd, u); p < nuEnd; p++){
+            int x = *p;
+            const int *nx = upper_bound(g.nbr.data() + g.offset[x], g.nbr.data() + g.offset[x + 1], x);
+            partial[t] += intersectCount(p + 1, nuEnd - p - 1, nx, g.nbr.data() + g.offset[x + 1] - nx);
+        }
+    });
+    long long total = 0;
+    for(long long c : partial)
+        total += c;
+    return total;
+}
+
+/* Local clustering coefficient - fraction of pairs of neighbours of u which are connected
+cc[u] = (no. of edges between neighbours of u) / (d * (d - 1) / 2), 0 if degree < 2
+Edges between neighbours = sum over neighbours x of |N(u) and N(x) common| / 2
+Returns average clustering coefficient, g must be sorted
+*/
+double clusteringCoefficient(const CSRGraph &g, vector<double> &cc, int threads = 1){
+    cc.assign(g.v, 0.0);
+    parallelForVertices(g.v, threads, [&](int, int u){
+        long long d = g.degree(u);
+        if(d < 2)
+            return;
+        const int *nu = g.nbr.data() + g.offset[u];
+        long long links = 0;
+        for(int i = g.offset[u]; i < g.offset[u + 1]; i++){
+            int x = g.nbr[i];
+            links += intersectCount(nu, d, g.nbr.data() + g.offset[x], g.degree(x));
+        }
+        cc[u] = (double)links / (d * (d - 1));  // links counts every edge twice
+    });
+    double sum = 0;
+    for(double c : cc)
+        sum += c;
+    return g.v ? sum / g.v : 0;
+}
+
+// Benchmark - intersectCount() vs std::set_intersection on random sorted sets of given size
+void benchIntersection(int size, int pairs = 2000){
+    mt19937 rng(21);
+    vector<vector<int>> sets(pairs * 2);
+    for(auto &s : sets){
+        s.resize(size);
+        for(int &x : s)
+            x = rng() % (size * 4);  // ~25% common elements
+        sort(s.begin(), s.end());
+        s.erase(unique(s.begin(), s.end()), s.end());
+    }
+    vector<int> out;
+    out.reserve(size);
+    long long c1 = 0, c2 = 0, c3 = 0;
+    auto start = chrono::steady_clock::now();
+    for(int k = 0; k < pairs; k++){
+        out.clear();
+        set_intersection(sets[2 * k].begin(), sets[2 * k].end(), sets[2 * k + 1].begin(), sets[2 * k + 1].end(), back_inserter(out));
+        c1 += out.size();
+    }
+    double tStd = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    for(int k = 0; k < pairs; k++)
+        c2 += intersectCountScalar(sets[2 * k].data(), sets[2 * k].size(), sets[2 * k + 1].data(), sets[2 * k + 1].size());
+    double tScalar = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    for(int k = 0; k < pairs; k++)
+        c3 += intersectCount(sets[2 * k].data(), sets[2 * k].size(), sets[2 * k + 1].data(), sets[2 * k + 1].size());
+    double tSimd = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "std::set_intersection : " << tStd << " s" << endl;
+    cout << "scalar merge          : " << tScalar << " s" << endl;
+    cout << "SIMD                  : " << tSimd << " s" << endl;
+    cout << "same counts           : " << (c1 == c2 && c2 == c3 ? "yes" : "no") << endl;
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Minimum spanning tree (MST)
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Spanning tree - v - 1 edges connecting all the vertices (no cycle), MST = one with minimum total weight
+For a disconnected graph, a minimum spanning forest (one tree per component) is returned
+Kruskal - sort edges by weight, take an edge if its ends are in different trees (union find)
+        - O(e log e), best for sparse graphs
+Prim - grow one tree, always add the lightest edge leaving it (like Dijkstra, key = edge weight, not distance)
+     - O(e log_d v) with IndexedMinHeap, best for dense graphs
+*/
+struct WeightedEdge{
+    int u, v, w;
+};
+
+/* Parallel sort - array divided in equal parts, every thread sorts one part,
+then neighbouring sorted parts are merged in rounds (half the threads every round)
+*/
+void parallelSortEdges(vector<WeightedEdge> &edges, int threads){
+    auto byWeight = [](const WeightedEdge &a, const WeightedEdge &b){ return a.w < b.w; };
+    size_t n = edges.size();
+    threads = max(1, min<int>(threads, n / 1024 + 1));  // Small arrays are not worth splitting
+    vector<size_t> bound(threads + 1);
+    for(int t = 0; t <= threads; t++)
+        bound[t] = n * t / threads;
+
+    vector<thread> pool;
+    for(int t = 0; t < threads; t++)
+        pool.emplace_back([&, t]{ sort(edges.begin() + bound[t], edges.begin() + bound[t + 1], byWeight); });
+    for(auto &th : pool)
+        th.join();
+
+    for(int width = 1; width < threads; width *= 2){    // Merging parts t and t + width
+        pool.clear();
+        for(int t = 0; t + width < threads; t += 2 * width){
+            size_t lo = bound[t], mid = bound[t + width], hi = bound[min(t + 2 * width, threads)];
+            pool.emplace_back([&edges, lo, mid, hi, byWeight]{
+                inplace_merge(edges.begin() + lo, edges.begin() + mid, edges.begin() + hi, byWeight);
+            });
+        }
+        for(auto &th : pool)
+            th.join();
+    }
+}
+
+// Returns total weight, mst gets the chosen edges
+long long kruskalMST(vector<WeightedEdge> edges, int v, vector<WeightedEdge> &mst, int threads = 1){
+    parallelSortEdges(edges, threads);
+    ConcurrentDSU dsu(v);
+    mst.clear();
+    long long total = 0;
+    for(auto &e : edges){
+        if((int)mst.size() == v - 1)    // Tree complete
+            break;
+        if(dsu.find(e.u) != dsu.find(e.v)){
+            dsu.unite(e.u, e.v);
+            mst.push_back(e);
+            total += e.w;
+        }
+    }
+    return total;
+}
+
+// Prim over the weighted adjacency list of dijkstra(), restarted from every vertex not yet in a tree
+long long primMST(vector<pair<int, int>> adj[], int v, vector<WeightedEdge> &mst, int arity = 4){
+    IndexedMinHeap h(v, arity);
+    vector<int> parent(v, -1), key(v, INT_MAX);
+    vector<bool> inTree(v, false);
+    mst.clear();
+    long long total = 0;
+    for(int s = 0; s < v; s++){
+        if(inTree[s])
+            continue;
+        key[s] = 0;
+        h.insert(s, 0);
+        while(h.empty() == false){
+            int u = h.extractMin();
+            inTree[u] = true;
+            if(parent[u] != -1){
+                mst.push_back({parent[u], u, key[u]});
+                total += key[u];
+            }
+            for(auto &e : adj[u]){
+                int x = e.first, w = e.second;
+                if(inTree[x] == false && w < key[x]){
+                    key[x] = w;
+                    parent[x] = u;
+                    if(h.contains(x))
+                        h.decreaseKey(x, w);
+                    else
+                        h.insert(x, w);
+                }
+            }
+        }
+    }
+    return total;
+}
+
+/* Picks the algorithm by density - Prim when average degree > log2(v) (heap is small compared to the edges),
+else Kruskal (sorting few edges is cheaper than building adjacency lists)
+*/
+long long minimumSpanningTree(const vector<WeightedEdge> &edges, int v, vector<WeightedEdge> &mst, int threads = 1){
+    double avgDegree = v ? 2.0 * edges.size() / v : 0;
+    if(avgDegree > log2(max(2, v))){
+        vector<vector<pair<int, int>>> adjStore(v);
+        for(auto &e : edges)
+            addEdge_W(adjStore.data(), e.u, e.v, e.w);
+        return primMST(adjStore.data(), v, mst);
+    }
+    return kruskalMST(edges, v, mst, threads);
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// A* search on grid graphs
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Grid graph - rows x cols cells, some cells blocked, vertex id = r * cols + c
+Neighbours are calculated from the position, no adjacency list is stored (1 byte per cell)
+    - 4 connected - up, down, left, right, cost 10
+    - 8 connected - diagonals also, cost 14 (~10 * sqrt(2)), diagonal move not allowed through a blocked corner
+Costs are integers scaled by 10 so the heap keys stay int
+*/
+struct GridGraph{
+    int rows, cols;
+    bool diagonal;
+    vector<char> blocked;
+
+    GridGraph(int r, int c, bool diag = false){
+        rows = r;
+        cols = c;
+        diagonal = diag;
+        blocked.assign(r * c, 0);
+    }
+
+    bool isFree(int r, int c) const{
+        return r >= 0 && r < rows && c >= 0 && c < cols && blocked[r * cols + c] == 0;
+    }
+};
+
+/* Heuristic - lower bound of the cost from (r1, c1) to (r2, c2), it should never over estimate
+    - Manhattan - 4 connected grid
+    - octile - 8 connected grid, diagonal steps for min(dx, dy) and straight steps for the rest
+*/
+typedef int (*GridHeuristic)(int r1, int c1, int r2, int c2);
+
+int manhattan(int r1, int c1, int r2, int c2){
+    return 10 * (abs(r1 - r2) + abs(c1 - c2));
+}
+
+int octile(int r1, int c1, int r2, int c2){
+    int dx = abs(r1 - r2), dy = abs(c1 - c2);
+    return 10 * max(dx, dy) + 4 * min(dx, dy);
+}
+
+/* A* - Dijkstra where the heap key is f = g + h
+    - g[u] = cost from source found so far, h = heuristic to the target
+    - vertices towards the target are taken first, so far fewer vertices are expanded than BFS
+Open set heap and per vertex data are kept in the struct and reused for every query
+(data is stamped with the query no., like bidirectionalBFS())
+Returns cost (-1 if not reachable), path gets the vertices from s to t if given
+*/
+struct GridAStar{
+    IndexedMinHeap open;
+    vector<int> g, parent, stamp;
+    vector<char> closed;
+    int query = 0;
+
+    GridAStar(const GridGraph &grid) : open(grid.rows * grid.cols, 4){
+        int n = grid.rows * grid.cols;
+        g.assign(n, 0);
+        parent.assign(n, -1);
+        stamp.assign(n, 0);
+        closed.assign(n, 0);
+    }
+
+    int search(const GridGraph &grid, int s, int t, GridHeuristic h, vector<int> *path = NULL){
+        static const int dr[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+        static const int dc[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+        query++;
+        open.clear();
+        if(path != NULL)
+            path->clear();
+        int tr = t / grid.cols, tc = t % grid.cols;
+        int moves = grid.diagonal ? 8 : 4;
+
+        stamp[s] = query;
+        closed[s] = 0;
+        g[s] = 0;
+        parent[s] = -1;
+        open.insert(s, h(s / grid.cols, s % grid.cols, tr, tc));
+        while(open.empty() == false){
+            int u = open.extractMin();
+            if(u == t)
+                break;
+            closed[u] = 1;
+            int r = u / grid.cols, c = u % grid.cols;
+            for(int k = 0; k < moves; k++){
+                int nr = r + dr[k], nc = c + dc[k];
+                if(grid.isFree(nr, nc) == false)
+                    continue;
+                if(k >= 4 && (grid.isFree(r, nc) == false || grid.isFree(nr, c) == false))  // Corner cutting
+                    continue;
+                int x = nr * grid.cols + nc;
+                int cost = g[u] + (k < 4 ? 10 : 14);
+                if(stamp[x] != query){  // First time seen in this query
+                    stamp[x] = query;
+                    closed[x] = 0;
+                }
+                else if(closed[x] || cost >= g[x])
+                    continue;
+                g[x] = cost;
+                parent[x] = u;
+                int f = cost + h(nr, nc, tr, tc);
+                if(open.contains(x))
+                    open.decreaseKey(x, f);
+                else
+                    open.insert(x, f);
+            }
+        }
+        if(stamp[t] != query)
+            return -1;
+        if(path != NULL){
+            for(int x = t; x != -1; x = parent[x])
+                path->push_back(x);
+            reverse(path->begin(), path->end());
+        }
+        return g[t];
+    }
+};
+
+/* Benchmark - random maze like grid (given % of cells blocked), 4 connected
+A* (Manhattan) vs shortestPath() on the adjacency list of the same grid, for random pairs of cells
+shortestPath() hop count * 10 must be equal to the A* cost
+*/
+void benchAStar(int rows, int cols, int blockedPercent = 25, int queries = 50){
+    mt19937 rng(19);
+    GridGraph grid(rows, cols);
+    for(auto &b : grid.blocked)
+        b = (int)(rng() % 100) < blockedPercent;
+    int v = rows * cols;
+    vector<vector<int>> adjStore(v);
+    for(int r = 0; r < rows; r++){
+        for(int c = 0; c < cols; c++){
+            if(grid.isFree(r, c) == false)
+                continue;
+            if(grid.isFree(r, c + 1))
+                addEdge_UD(adjStore.data(), r * cols + c, r * cols + c + 1);
+            if(grid.isFree(r + 1, c))
+                addEdge_UD(adjStore.data(), r * cols + c, (r + 1) * cols + c);
+        }
+    }
+    GridAStar astar(grid);
+    vector<int> dist(v);
+    double tBFS = 0, tAStar = 0;
+    bool ok = true;
+    for(int q = 0; q < queries; q++){
+        int s, t;
+        do{ s = rng() % v; } while(grid.blocked[s]);
+        do{ t = rng() % v; } while(grid.blocked[t]);
+        auto start = chrono::steady_clock::now();
+        shortestPathDist(adjStore.data(), v, s, dist.data());
+        tBFS += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        int cost = astar.search(grid, s, t, manhattan);
+        tAStar += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        int expected = (dist[t] == INT16_MAX) ? -1 : 10 * dist[t];
+        ok = ok && cost == expected;
+    }
+    cout << "shortestPath : " << tBFS << " s" << endl;
+    cout << "A*           : " << tAStar << " s" << endl;
+    cout << "same costs   : " << (ok ? "yes" : "no") << endl;
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Vertex centric iteration engine - PageRank
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Every iteration every vertex computes its new value from the values of its in-neighbours (pull)
+    - pass 1 - every vertex x gives contrib[x] (what it sends on each out edge) and a part of a global value
+    - pass 2 - new value of u = apply(u, sum of contrib of in-neighbours, global)
+Pull needs in-neighbours, so the engine works on the transpose (gin) of the graph
+Nothing is written to another thread's vertices, so no atomics or locks are needed
+Static partitioning - vertices divided in continuous ranges with about equal no. of in-edges,
+each thread always works on the same range and initialises it itself (first touch),
+so on a NUMA machine the memory of a range is on the node of the thread using it
+Stops when sum of |new - old| < tolerance or after maxIter iterations
+Program needs
+    - double init(int u)                           - starting value
+    - double contrib(int x, double value)         - value sent along every out edge of x
+    - double global(int x, double value)          - part of a global sum (e.g. dangling rank), 0 if not needed
+    - double apply(int u, double sum, double g)   - new value
+*/
+template<class Program>
+vector<double> runVertexProgram(const CSRGraph &gin, Program &prog, int threads, double tolerance, int maxIter, bool report){
+    int n = gin.v;
+    vector<int> bound(threads + 1, n);  // Range of thread t = [bound[t], bound[t + 1])
+    bound[0] = 0;
+    long long work = (long long)gin.offset[n] + n;
+    for(int t = 1; t < threads; t++){   // First vertex where edges + vertices crosses t / threads of the work
+        int lo = 0, hi = n;
+        while(lo < hi){
+            int mid = (lo + hi) / 2;
+            if((long long)gin.offset[mid] + mid < work * t / threads)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        bound[t] = lo;
+    }
+
+    unique_ptr<double[]> curr(new double[n]), next(new double[n]), contrib(new double[n]);  // Not initialised here - first touch
+    vector<double> globalPart(threads), diffPart(threads);
+    Barrier sync(threads);
+    bool done = false;
+    int iter = 0;
+    auto iterStart = chrono::steady_clock::now();
+
+    auto worker = [&](int t){
+        int lo = bound[t], hi = bound[t + 1];
+        for(int u = lo; u < hi; u++){
+            curr[u] = prog.init(u);
+            next[u] = 0;
+        }
+        sync.wait();
+        while(true){
+            double g = 0;
+            for(int x = lo; x < hi; x++){
+                contrib[x] = prog.contrib(x, curr[x]);
+                g += prog.global(x, curr[x]);
+            }
+            globalPart[t] = g;
+            sync.wait();
+            double total = 0;
+            for(double p : globalPart)
+                total += p;
+            double diff = 0;
+            for(int u = lo; u < hi; u++){
+                double sum = 0;
+                for(int i = gin.offset[u]; i < gin.offset[u + 1]; i++)
+                    sum += contrib[gin.nbr[i]];
+                next[u] = prog.apply(u, sum, total);
+                diff += fabs(next[u] - curr[u]);
+            }
+            diffPart[t] = diff;
+            sync.wait();
+            if(t == 0){ // One thread checks convergence and reports
+                double change = 0;
+                for(double d : diffPart)
+                    change += d;
+                iter++;
+                swap(curr, next);
+                if(report){
+                    double secs = chrono::duration<double>(chrono::steady_clock::now() - iterStart).count();
+                    cout << "iteration " << iter << " : " << secs * 1000 << " ms, change " << change << endl;
+                }
+                done = change < tolerance || iter >= maxIter;
+                iterStart = chrono::steady_clock::now();
+            }
+            sync.wait();
+            if(done)
+                break;
+        }
+    };
+    vector<thread> pool;
+    for(int t = 1; t < threads; t++)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for(auto &th : pool)
+        th.join();
+    return vector<double>(curr.get(), curr.get() + n);
+}
+
+/* PageRank - importance of a vertex = sum of importance of vertices pointing to it, shared equally among their out edges
+rank[u] = (1 - d) / n + d * (sum of rank[x] / outdegree[x] over in-neighbours x + dangling / n)
+dangling = total rank of vertices with no out edge, spread to every vertex so that ranks always add up to 1
+*/
+struct PageRankProgram{
+    const CSRGraph &g;
+    double d;
+    int n;
+
+    PageRankProgram(const CSRGraph &graph, double damping) : g(graph){
+        d = damping;
+        n = graph.v;
+    }
+
+    double init(int){
+        return 1.0 / n;
+    }
+
+    double contrib(int x, double rank){
+        return g.degree(x) ? rank / g.degree(x) : 0;
+    }
+
+    double global(int x, double rank){
+        return g.degree(x) ? 0 : rank;
+    }
+
+    double apply(int, double sum, double dangling){
+        return (1 - d) / n + d * (sum + dangling / n);
+    }
+};
+
+// g has out edges (for undirected graph both directions are stored already)
+vector<double> pageRank(const CSRGraph &g, int threads = 1, double damping = 0.85, double tolerance = 1e-6, int maxIter = 100, bool report = true){
+    CSRGraph gin = transposeCSR(g);
+    PageRankProgram prog(g, damping);
+    return runVertexProgram(gin, prog, threads, tolerance, maxIter, report);
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// Benchmark suite
+//----------------------------------------------------------------------------------------------------------------------------------------
+/* Synthetic graphs (edge lists, used as undirected or as directed u -> v)
+    - R-MAT        - rmatEdges(), power law degrees like social/web graphs
+    - Erdos Renyi  - e edges with both ends chosen uniformly at random
+    - grid         - rows x cols, edges to right and down neighbour (road/maze like, large diameter)
+    - chain        - 0 - 1 - 2 ... - (v - 1), the worst case for recursive DFS
+*/
+vector<pair<int, int>> erdosRenyiEdges(int v, long long e, unsigned seed = 1){
+    mt19937 rng(seed);
+    vector<pair<int, int>> edges;
+    edges.reserve(e);
+    for(long long k = 0; k < e; k++)
+        edges.push_back({(int)(rng() % v), (int)(rng() % v)});
+    return edges;
+}
+
+vector<pair<int, int>> gridEdges(int rows, int cols){
+    vector<pair<int, int>> edges;
+    for(int r = 0; r < rows; r++){
+        for(int c = 0; c < cols; c++){
+            int u = r * cols + c;
+            if(c + 1 < cols)
+                edges.push_back({u, u + 1});
+            if(r + 1 < rows)
+                edges.push_back({u, u + cols});
+        }
+    }
+    return edges;
+}
+
+vector<pair<int, int>> chainEdges(int v){
+    vector<pair<int, int>> edges;
+    for(int i = 0; i + 1 < v; i++)
+        edges.push_back({i, i + 1});
+    return edges;
+}
+
+// Peak resident memory of the process in MB
+double peakRSSMB(){
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss / 1024.0;   // ru_maxrss is in KB on Linux
+}
+
+// CPU time stamp counter, 0 where it is not available
+unsigned long long cycleCount(){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/* Runs BFS1, DFS, shortestPath, islandBFS, Ucycle and Dcycle (printing switched off / non printing versions)
+on one generated graph with 2^scale vertices
+    - kind = "rmat", "er" (16 edges per vertex), "grid" (square) or "chain"
+    - TEPS = traversed edges per second, counted as all stored adjacency entries,
+      so it is an upper bound for Ucycle/Dcycle which stop at the first cycle
+    - cycles per edge from the time stamp counter
+*/
+void runGraphBenchmarks(const string &kind, int scale, int rounds = 3){
+    int v = 1 << scale;
+    vector<pair<int, int>> edges;
+    if(kind == "er")
+        edges = erdosRenyiEdges(v, 16LL * v);
+    else if(kind == "grid"){
+        int side = 1 << (scale / 2);
+        v = side * side;
+        edges = gridEdges(side, side);
+    }
+    else if(kind == "chain")
+        edges = chainEdges(v);
+    else
+        edges = rmatEdges(scale, 16);
+
+    vector<vector<int>> adjStore(v), dirStore(v);
+    vector<int> *adj = adjStore.data(), *dir = dirStore.data();
+    for(auto &e : edges){
+        addEdge_UD(adj, e.first, e.second);
+        dir[e.first].push_back(e.second);
+    }
+    int source = 0;
+    for(int i = 0; i < v; i++){
+        if(adj[i].size() > adj[source].size())
+            source = i;
+    }
+    vector<int> dist(v);
+    cout << kind << ": " << v << " vertices, " << edges.size() << " edges" << endl;
+
+    auto measure = [&](const char *name, double traversed, function<void()> run){
+        auto start = chrono::steady_clock::now();
+        unsigned long long c0 = cycleCount();
+        for(int r = 0; r < rounds; r++)
+            run();
+        unsigned long long c1 = cycleCount();
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count() / rounds;
+        cout << "  " << name << " : " << secs << " s, " << traversed / secs / 1e6 << " MTEPS, "
+             << (double)(c1 - c0) / rounds / traversed << " cycles/edge" << endl;
+    };
+    double undirectedEdges = 2.0 * edges.size(), directedEdges = edges.size();
+    measure("BFS1        ", undirectedEdges, [&]{ BFS1(adj, v, source, false); });
+    measure("DFS         ", undirectedEdges, [&]{ DFS(adj, v, source, false); });
+    measure("shortestPath", undirectedEdges, [&]{ shortestPathDist(adj, v, source, dist.data()); });
+    measure("islandBFS   ", undirectedEdges, [&]{ islandBFS(adj, v); });
+    measure("Ucycle      ", undirectedEdges, [&]{ Ucycle(adj, v); });
+    measure("Dcycle      ", directedEdges, [&]{ Dcycle(dir, v); });
+    cout << "  peak RSS : " << peakRSSMB() << " MB" << endl;
+}
+//----------------------------------------------------------------------------------------------------------------------------------------
+
+// ./graph                    - small example
+// ./graph bench <kind> <scale> - runGraphBenchmarks(), kind = rmat, er, grid or chain
+/* Benchmarks of the single features (each one also checks its answers against the simple version)
+name = csr, pbfs, iterdfs, components, dijkstra, msbfs, load, reorder, dynamic, intersect, astar or all
+Sizes are derived from scale (about 2^scale vertices), returns false for an unknown name
+*/
+bool runNamedBenchmark(const string &name, int scale){
+    int v = 1 << scale;
+    int threads = max(1u, thread::hardware_concurrency());
+    vector<pair<string, function<void()>>> table = {
+        {"csr", [&]{ benchCSR(v, 8 * v); }},
+        {"pbfs", [&]{ benchParallelBFS(scale); }},
+        {"iterdfs", [&]{ benchIterDFS(v); }},
+        {"components", [&]{ benchComponents(v, 4 * v, threads); }},
+        {"dijkstra", [&]{ benchDijkstra(1 << (scale / 2), 1 << (scale - scale / 2)); }},
+        {"msbfs", [&]{ benchMultiSourceBFS(v, 8 * v, 256); }},
+        {"load", [&]{ benchGraphLoad(v, 8 * v); }},
+        {"reorder", [&]{ benchReordering(scale); }},
+        {"dynamic", [&]{ benchDynamicGraph(v, 2000); }},    // Checking from scratch is O(v + e) per update
+        {"intersect", [&]{ benchIntersection(1 << (scale / 2)); }},
+        {"astar", [&]{ benchAStar(1 << (scale / 2), 1 << (scale - scale / 2)); }},
+    };
+    bool found = false;
+    for(auto &entry : table){
+        if(name == entry.first || name == "all"){
+            cout << "-- " << entry.first << " (scale " << scale << ")" << endl;
+            entry.second();
+            found = true;
+        }
+    }
+    return found;
+}
+
+/* ./graph                       - small example below
+   ./graph bench <kind> <scale>  - traversal suite of runGraphBenchmarks(), kind = rmat, er, grid or chain
+   ./graph bench <name> <scale>  - one feature benchmark of runNamedBenchmark(), or all of them
+*/
+int main(int argc, char *argv[]){
+    if(argc > 1 && string(argv[1]) == "bench"){
+        string name = argc > 2 ? argv[2] : "rmat";
+        int scale = argc > 3 ? atoi(argv[3]) : 16;
+        if(name == "rmat" || name == "er" || name == "grid" || name == "chain")
+            runGraphBenchmarks(name, scale);
+        else if(runNamedBenchmark(name, scale) == false){
+            cout << "unknown benchmark " << name << ", use rmat, er, grid, chain, csr, pbfs, iterdfs, components,"
+                 << " dijkstra, msbfs, load, reorder, dynamic, intersect, astar or all" << endl;
+            return 1;
+        }
+        return 0;
+    }
+    int v = 6;  // Vertices 0 to 5 are used below
     vector<int> adj[v];
     addEdge_UD(adj, 4, 5);
     addEdge_UD(adj, 4, 2);
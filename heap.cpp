@@ -2,6 +2,17 @@
 #include <iostream>
 #include <cmath>
 #include <queue>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <new>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <cstdlib>
 using namespace std;
 
 // Max heap - Complete binary tree; all descendants are smaller than the root
@@ -19,6 +30,37 @@ struct MinHeap{
         capacity = c;
     }
 
+    // Bulk constructor - heap of all the elements in [first, last), built in O(n) instead of n inserts (O(nlogn))
+    template<class It>
+    MinHeap(It first, It last){
+        capacity = distance(first, last);
+        arr = new int[capacity];
+        size = 0;
+        for(It it = first; it != last; it++)
+            arr[size++] = *it;
+        buildMinHeap();
+    }
+
+    ~MinHeap(){
+        delete[] arr;
+    }
+
+    // Owns arr, so copying would delete it twice
+    MinHeap(const MinHeap &) = delete;
+    MinHeap &operator=(const MinHeap &) = delete;
+
+    // Grows the array to hold at least c elements, used when a batch does not fit
+    // Callers grow it at least 2 times, so n elements added in small batches are copied O(n) times in total (amortised O(1))
+    void reserve(int c){
+        if(c <= capacity)
+            return;
+        int *bigger = new int[c];
+        copy(arr, arr + size, bigger);
+        delete[] arr;
+        arr = bigger;
+        capacity = c;
+    }
+
     // Returns left child of the given index
     int left(int i){
         return 2 * i + 1;
@@ -31,38 +73,76 @@ struct MinHeap{
 
     // Returns parent of the given index
     int parent(int i){
-        return floor((i - 1 / 2));
+        return (i - 1) / 2;
+    }
+
+    // Hole based sifting - used by every operation below
+    //-----------------------------------------------------------------------------------------
+    /* Sift up - element at i moves up till its parent is smaller
+    Approach - take the element out (hole at i), move parents down into the hole while they are greater
+             - write the element once where the hole stops (1 write per level instead of a 3 write swap)
+    Time complexity - O(logn), Auxiliary space - O(1)
+    */
+    void siftUp(int i){
+        int x = arr[i];
+        while(i != 0 && arr[parent(i)] > x){
+            arr[i] = arr[parent(i)];
+            i = parent(i);
+        }
+        arr[i] = x;
     }
 
+    /* Sift down for a min heap of n elements - element at i moves down till both children are greater
+    Approach - same hole idea, move the smaller child up into the hole
+             - smaller child is selected as c + (arr[c + 1] < arr[c]), compiler makes it a conditional move (cmov)
+               so the 50-50 "left or right" decision is not a branch that the CPU keeps mispredicting
+    Time complexity - O(logn), Auxiliary space - O(1) (iterative, no recursion)
+    */
+    void siftDownMin(int arr[], int n, int i){
+        int x = arr[i];
+        int c;
+        while((c = 2 * i + 1) < n){
+            if(c + 1 < n)
+                c += arr[c + 1] < arr[c];
+            if(arr[c] >= x)
+                break;
+            arr[i] = arr[c];
+            i = c;
+        }
+        arr[i] = x;
+    }
+
+    // Same as siftDownMin(), but for a max heap (greater child goes up)
+    void siftDownMax(int arr[], int n, int i){
+        int x = arr[i];
+        int c;
+        while((c = 2 * i + 1) < n){
+            if(c + 1 < n)
+                c += arr[c + 1] > arr[c];
+            if(arr[c] <= x)
+                break;
+            arr[i] = arr[c];
+            i = c;
+        }
+        arr[i] = x;
+    }
+    //-----------------------------------------------------------------------------------------
+
     // Inserting a new element to the node and even maintain minHeap properties after it
     void insert(int x){
         if(size == capacity)
             return;
         arr[size] = x;
         size++;
-        for(int i = size - 1; i != 0 && arr[parent(i)] > arr[i]; ){
-            swap(arr[i], arr[parent(i)]);
-            i = parent(i);
-        }
+        siftUp(size - 1);
     }
 
     // Heapify - only one node is wrong to dissatisfy minHeap property
     // Makes the binary heap a proper minHeap
     // Time complexity - O(h) ~ O(logn), but h for complete binary tree = log n
-    // Auxiliary space - O(h)
+    // Auxiliary space - O(1), iterative sift down
     void minHeapify(int i){
-        int lt = left(i);
-        int rt = right(i);
-        int minimum = i;
-        if(lt < size && arr[i] > arr[lt]){
-            minimum = lt;
-        }
-        if(rt < size && arr[i] > arr[minimum])
-            minimum = rt;
-        if(minimum != i){
-            swap(arr[i], arr[minimum]);
-            minHeapify(minimum);
-        }
+        siftDownMin(arr, size, i);
     }
 
     // Get minimum of the binary heap
@@ -84,20 +164,18 @@ struct MinHeap{
             size--;
             return arr[0];
         }
-        swap(arr[0], arr[size - 1]);
+        int res = arr[0];
         size--; // Removing the last element
+        arr[0] = arr[size]; // Last element goes to the root and moves down
         minHeapify(0);
-        return arr[size];
+        return res;
     }
 
     // Decrease operation - maintain the heap even after decreasing
     // Time complexity - O(logn)
     void decreaseKey(int i, int x){
         arr[i] = x; // Updating the value to the given value at the specified index
-        while(i != 0 && arr[parent(i)] > arr[i]){
-            swap(arr[i], arr[parent(i)]);
-            i = parent(i);
-        }
+        siftUp(i);
     }
 
     // Delete operation - should follow minHeap property even after deleting
@@ -111,56 +189,97 @@ struct MinHeap{
     /* Approach - Make the parent of last element (node) as a proper minHeap
     Time complexity - O(n), check video for detialed explaination
     */
-    void buildMinHeap(){  // No parameters, so use insert() for adding elements to heap and then call it
-        int start = (size - 1) - 1 / 2; // parent of last element
-        for(int i = start; i >= 0; i--)
-            minHeapify(i);  // Bottom to top approach
+    void buildMinHeap(){  // No parameters, so use insert() / insertBatch() / bulk constructor for adding elements and then call it
+        buildMinHeap(arr, size);
+    }
+
+    // Insert many elements at once
+    /* Approach - append all of them, then
+                - few elements (k * logn < n) - sift up each one, O(klogn)
+                - many elements - build the whole heap again bottom up, O(n + k)
+    */
+    template<class It>
+    void insertBatch(It first, It last){
+        int k = distance(first, last);
+        if(size + k > capacity)
+            reserve(max(size + k, 2 * capacity));
+        int old = size;
+        for(It it = first; it != last; it++)
+            arr[size++] = *it;
+        if((double)k * log2(size + 1) < size){
+            for(int i = old; i < size; i++)
+                siftUp(i);
+        }
+        else
+            buildMinHeap();
     }
     //***************************************************************************************************************************************
     // Overriding buildMinHeap() and minHeapify() for later uses
 
+    /* Floyd's bottom up build, cache blocked
+    Plain Floyd - heapify parents from the last one to the root, one level at a time
+                - for big n a level is bigger than the cache, so when a node moves down, the levels below are already evicted
+    Blocked - subtree of height <= BLOCK_HEIGHT (2^14 ints = 64 KB, fits in L2) is built level by level on its own
+            - bigger subtree = build left subtree, build right subtree, then sift down its root (depth first)
+            - so the lower levels are finished while they are still in cache
+    Time complexity - O(n) (same work as plain Floyd, only the order changes)
+    Blocking only pays off once the heap is far bigger than L2 - below BLOCKED_MIN (2^23 ints = 32 MB) it was
+    5-15% slower than plain Floyd (benchHeapBuild), so plain Floyd is used for smaller heaps
+    */
+    static const int BLOCK_HEIGHT = 14;
+    static const int BLOCKED_MIN = 1 << 23;
+
     void buildMinHeap(int arr[], int n){
-        int start = (n - 1) - 1 / 2;
-        for(int i = start; i >= 0; i--)
-            minHeapify(arr, n, i);
+        if(n < BLOCKED_MIN){
+            for(int i = (n - 2) / 2; i >= 0; i--)   // Parent of last element down to the root
+                minHeapify(arr, n, i);
+            return;
+        }
+        buildBlocked(arr, n);
     }
 
-    void minHeapify(int arr[], int n, int i){
-        int lt = 2 * i + 1;
-        int rt = 2 * i + 2;
-        int minimum = i;
-        if(lt < n && arr[lt] < arr[minimum])
-            minimum = lt;
-        if(rt < n && arr[rt] < arr[minimum])
-            minimum = rt;
-        if(minimum != i){
-            swap(arr[minimum], arr[i]);
-            minHeapify(arr, n, minimum);
+    void buildBlocked(int arr[], int n){
+        int height = 0; // Number of levels
+        while((1LL << height) - 1 < n)
+            height++;
+        buildSubtree(arr, n, 0, height);
+    }
+
+    // Builds the subtree rooted at r, h = levels in the subtree (counted as if the tree was full)
+    void buildSubtree(int arr[], int n, int r, int h){
+        if(r >= n)
+            return;
+        if(h > BLOCK_HEIGHT){
+            buildSubtree(arr, n, 2 * r + 1, h - 1);
+            buildSubtree(arr, n, 2 * r + 2, h - 1);
+            minHeapify(arr, n, r);
+            return;
+        }
+        // Nodes of this subtree at depth d (from r) are (r + 1) * 2^d - 1 ... (r + 1) * 2^d - 1 + 2^d - 1
+        for(int d = h - 2; d >= 0; d--){
+            long long from = ((long long)(r + 1) << d) - 1;
+            long long to = min(from + (1LL << d), (long long)n);
+            for(long long i = to - 1; i >= from; i--)
+                minHeapify(arr, n, i);
         }
     }
+
+    void minHeapify(int arr[], int n, int i){
+        siftDownMin(arr, n, i);
+    }
     //****************************************************************************************************************************************
     
     // Same as minHeapify(), but creates a maxHeap
     // Why extra parameters - will be used for sorting heap
     //                      - bcoz of this it can be called for an array directly, without inserting the elements of the array to the heap using insert()
     void maxHeapify(int arr[], int n, int i){
-        int lt = left(i);
-        int rt = right(i);
-        int maximum = i;
-        if(lt < n && arr[maximum] < arr[lt])
-            maximum = lt;
-        if(rt < n && arr[maximum] < arr[rt])
-            maximum = rt;
-        if(maximum != i){
-            swap(arr[i], arr[maximum]);
-            maxHeapify(arr, n, maximum);
-        }
+        siftDownMax(arr, n, i);
     }
 
     // Same as buildMinHeap(), but builds a maxHeap
     // Additional parameters help to call directly for an array
     void buildMaxHeap(int arr[], int n){
-        int start = (n - 1) - 1 / 2;
+        int start = (n - 2) / 2; // parent of last element
         for(int i = start; i >= 0; i--)
             maxHeapify(arr, n, i);
     }
@@ -186,8 +305,10 @@ struct MinHeap{
     // Sort a K-sorted array - imp
     // An element at i index in sorted array will be present between i-k to i+k in unsorted array
     // Time complexity - O(n + klogk)
+    // MinQ - any min heap with push/top/pop/empty, e.g. sortK<PairingHeap<int, greater<int>>>(arr, n, k)
+    template<class MinQ = priority_queue<int, vector<int>, greater<int>>>
     void sortK(int arr[], int n, int k){
-        priority_queue<int, vector<int>, greater<int>> pq;  // Declaring a minHeap
+        MinQ pq;  // Declaring a minHeap
         
         // Maintaining minHeap for k elements
         for(int i = 0; i <= k; i++)   // O(klogk)
@@ -361,9 +482,10 @@ struct MinHeap{
         }
     };
 
+    template<class MinQ = priority_queue<Triplet, vector<Triplet>, Compare>>  // or PairingHeap<Triplet, Compare>
     vector<int> mergeKArrays3(vector<vector<int>> vect){
         vector<int> result;
-        priority_queue<Triplet, vector<Triplet>, Compare> pq; // Creating minHeap
+        MinQ pq; // Creating minHeap
 
         // Adding 1st element of all arrays
         for(int i = 0; i < vect.size(); i++){
@@ -396,9 +518,10 @@ struct MinHeap{
              - Here, we will be maintaining extra elements in left only
     Time complexity - O(nlogn)
     */
+    template<class MaxQ = priority_queue<int>, class MinQ = priority_queue<int, vector<int>, greater<int>>>
     void printMedian(int arr[], int n){
-        priority_queue<int> left;   // maxHeap
-        priority_queue<int, vector<int>, greater<int>> right;   // minHeap
+        MaxQ left;   // maxHeap
+        MinQ right;   // minHeap
 
         left.push(arr[0]);
         cout << arr[0] << " ";
@@ -429,7 +552,688 @@ struct MinHeap{
     }
 };
 
-int main(){
+// Generic heap - any element type, any ordering
+//*******************************************************************************************************************************************
+/* MinHeap above works only for int, has fixed capacity (insert is ignored when full)
+and returns INT16_MAX when empty, which can't be told apart from a real element
+Heap<T, Compare, Arity>
+    - T - element type, can be a struct with key and other data (payload)
+    - Compare - comp(a, b) = true if a should come out before b, less<T> gives a min heap
+                (opposite of priority_queue, where less<T> gives a max heap)
+    - Arity - no. of children of every node, 2 = binary heap
+    - stored in a vector, capacity doubles when full, so inserts are never dropped (amortised O(1) growth)
+    - elements are moved, not copied, and moved into a "hole" - written once at their final place
+    - getMin() / extractMin() return false when the heap is empty
+*/
+// Allocator giving 64 byte (cache line) aligned memory to the vector of Heap
+template<class T>
+struct CacheAlignedAllocator{
+    typedef T value_type;
+
+    CacheAlignedAllocator(){}
+
+    template<class U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U> &){}
+
+    T *allocate(size_t n){
+        return (T *)::operator new(n * sizeof(T), align_val_t(64));
+    }
+
+    void deallocate(T *p, size_t){
+        ::operator delete(p, align_val_t(64));
+    }
+
+    template<class U>
+    bool operator==(const CacheAlignedAllocator<U> &) const{
+        return true;
+    }
+
+    template<class U>
+    bool operator!=(const CacheAlignedAllocator<U> &) const{
+        return false;
+    }
+};
+
+/* Cache friendly layout
+    - array order of a heap is level order (Eytzinger layout), children of a node are next to each other
+    - root is stored at arr[Arity - 1] (first Arity - 1 slots unused), so the children of every node start at an index
+      that is a multiple of Arity; with 64 byte aligned memory, a group of children never crosses a cache line
+      when Arity * sizeof(T) <= 64 (4-ary / 8-ary / 16-ary of int) - one cache miss per level while moving down
+    - while moving down, the grandchildren are prefetched, so the next level is already on its way
+    - d-ary heap is log2(d) times shorter, so extractMin has fewer levels (each level compares d children)
+T must be default constructible (for the unused slots)
+*/
+template<class T, class Compare = less<T>, int Arity = 2>
+struct Heap{
+    static const int ROOT = Arity - 1;
+    vector<T, CacheAlignedAllocator<T>> arr;
+    Compare comp;
+
+    Heap(Compare c = Compare()) : arr(ROOT), comp(c){}
+
+    int size() const{
+        return arr.size() - ROOT;
+    }
+
+    bool empty() const{
+        return (int)arr.size() == ROOT;
+    }
+
+    // Reserve space for n elements, avoids growing again and again if n is known
+    void reserve(int n){
+        arr.reserve(n + ROOT);
+    }
+
+    // Index functions work on positions in arr (root = ROOT)
+    static int parent(int i){
+        return (i - ROOT - 1) / Arity + ROOT;
+    }
+
+    // First child of i, other children are next to it
+    static int child(int i){
+        return Arity * (i - ROOT) + 1 + ROOT;
+    }
+
+    void insert(T x){
+        arr.push_back(move(x));
+        siftUp(arr.size() - 1);
+    }
+
+    // Returns false if the heap is empty, else out = minimum
+    bool getMin(T &out) const{
+        if(empty())
+            return false;
+        out = arr[ROOT];
+        return true;
+    }
+
+    // Minimum without copying, heap must not be empty
+    const T &top() const{
+        return arr[ROOT];
+    }
+
+    // Returns false if the heap is empty, else removes the minimum into out
+    bool extractMin(T &out){
+        if(empty())
+            return false;
+        out = move(arr[ROOT]);
+        pop();
+        return true;
+    }
+
+    // Removes the minimum, heap must not be empty
+    void pop(){
+        if(size() > 1)
+            arr[ROOT] = move(arr.back());  // Last element goes to the root, then moves down
+        arr.pop_back();
+        if(empty() == false)
+            siftDown(ROOT);
+    }
+
+    // Same as MinHeap::decreaseKey(), i = position counted from the root (0 = root), x should come out before the old value
+    void decreaseKey(int i, T x){
+        arr[i + ROOT] = move(x);
+        siftUp(i + ROOT);
+    }
+
+    void siftUp(int i){
+        T x = move(arr[i]);
+        while(i > ROOT && comp(x, arr[parent(i)])){
+            arr[i] = move(arr[parent(i)]);
+            i = parent(i);
+        }
+        arr[i] = move(x);
+    }
+
+    void siftDown(int i){
+        int n = arr.size();
+        T x = move(arr[i]);
+        while(true){
+            int first = child(i);
+            if(first >= n)
+                break;
+            int grand = child(first);   // Grandchildren group of the first child, others follow it
+            if(grand < n)
+                __builtin_prefetch(&arr[grand]);
+            int best = first;
+            if(first + Arity <= n){
+                // Full group - fixed trip count, compiler unrolls it and uses conditional moves (no branch to mispredict)
+                for(int c = 1; c < Arity; c++)
+                    best = comp(arr[first + c], arr[best]) ? first + c : best;
+            }
+            else{
+                for(int c = first + 1; c < n; c++){
+                    if(comp(arr[c], arr[best]))
+                        best = c;
+                }
+            }
+            if(comp(arr[best], x) == false)
+                break;
+            arr[i] = move(arr[best]);
+            i = best;
+        }
+        arr[i] = move(x);
+    }
+};
+
+// Key with payload, ordered only by the key - e.g. Heap<Keyed<int, Record>, KeyLess>
+template<class K, class V>
+struct Keyed{
+    K key;
+    V value;
+};
+
+struct KeyLess{
+    template<class KV>
+    bool operator()(const KV &a, const KV &b) const{
+        return a.key < b.key;
+    }
+};
+
+struct KeyGreater{ // priority_queue / PairingHeap ordering for a min heap
+    template<class KV>
+    bool operator()(const KV &a, const KV &b) const{
+        return a.key > b.key;
+    }
+};
+
+// 64 byte record for the benchmark
+struct Record64{
+    int key;
+    char data[60];
+};
+
+struct Record64Greater{ // priority_queue needs greater for a min heap
+    bool operator()(const Record64 &a, const Record64 &b) const{
+        return a.key > b.key;
+    }
+};
+
+// Pairing heap - mergeable heap with handles
+//*******************************************************************************************************************************************
+/* Array heaps move elements on every sift, so the index passed to MinHeap::decreaseKey() changes all the time
+Pairing heap - a tree where every node is before all of its children, any number of children
+    - children list = first child + next sibling links, prev = left sibling (or parent for the first child)
+    - link(a, b) - the one which comes out later becomes the first child of the other - O(1)
+    - insert - link the new node with the root - O(1)
+    - meld - link the two roots - O(1)
+    - decreaseKey - cut the subtree of the node out and link it with the root - O(1), amortised less than O(logn)
+    - pop - pair up the children left to right, then link the pairs right to left (two pass) - amortised O(logn)
+Nodes live in an arena (vector of nodes + free list), not one new per node
+    - Handle = index of the node in the arena, stays the same till that element is popped (then it gets reused)
+    - heaps sharing one arena (PairingHeap(other.arena)) can be melded in O(1), handles of both stay valid
+    - heaps with different arenas cannot be melded, pushAll() moves the elements one by one instead (O(m), new handles)
+    - copying a heap copies its arena too, so the copy is independent like a copied priority_queue
+      (handles of the original can be used on the copy, they are the same indices)
+Compare works like priority_queue (drop-in) - comp(a, b) = true if a comes out after b, greater<T> gives a min heap
+*/
+template<class T, class Compare = less<T>>
+struct PairingHeap{
+    typedef int Handle;
+
+    struct Node{
+        T value;
+        int child, next, prev;
+    };
+
+    struct Arena{
+        vector<Node> nodes;
+        vector<int> freeList;
+    };
+
+    shared_ptr<Arena> arena;
+    int root = -1;
+    int count = 0;
+    Compare comp;
+    vector<int> scratch;    // Children list during pop, kept to avoid allocating every time
+
+    PairingHeap(Compare c = Compare()) : arena(make_shared<Arena>()), comp(c){}
+
+    PairingHeap(shared_ptr<Arena> shared, Compare c = Compare()) : arena(shared), comp(c){}
+
+    PairingHeap(const PairingHeap &other) : arena(make_shared<Arena>(*other.arena)), root(other.root), count(other.count), comp(other.comp){}
+
+    PairingHeap &operator=(const PairingHeap &other){
+        if(this != &other){
+            arena = make_shared<Arena>(*other.arena);
+            root = other.root;
+            count = other.count;
+            comp = other.comp;
+        }
+        return *this;
+    }
+
+    // Moving keeps the same arena (no copy), like moving a priority_queue
+    PairingHeap(PairingHeap &&) = default;
+    PairingHeap &operator=(PairingHeap &&) = default;
+
+    int size() const{
+        return count;
+    }
+
+    bool empty() const{
+        return count == 0;
+    }
+
+    Node &node(int i){
+        return arena->nodes[i];
+    }
+
+    // Element of a handle
+    const T &value(Handle h) const{
+        return arena->nodes[h].value;
+    }
+
+    const T &top() const{
+        return arena->nodes[root].value;
+    }
+
+    // Both a and b are roots (no parent, no siblings), returns the new root
+    int link(int a, int b){
+        if(comp(node(a).value, node(b).value))
+            swap(a, b);
+        Node &na = node(a);
+        Node &nb = node(b);
+        nb.next = na.child;
+        if(na.child != -1)
+            node(na.child).prev = b;
+        nb.prev = a;
+        na.child = b;
+        return a;
+    }
+
+    Handle push(T x){
+        int i;
+        if(arena->freeList.empty()){
+            i = arena->nodes.size();
+            arena->nodes.push_back({ move(x), -1, -1, -1 });
+        }
+        else{
+            i = arena->freeList.back();
+            arena->freeList.pop_back();
+            node(i) = { move(x), -1, -1, -1 };
+        }
+        root = root == -1 ? i : link(root, i);
+        count++;
+        return i;
+    }
+
+    void pop(){
+        int old = root;
+        scratch.clear();
+        for(int c = node(old).child; c != -1; ){
+            int next = node(c).next;
+            node(c).next = node(c).prev = -1;
+            scratch.push_back(c);
+            c = next;
+        }
+        arena->freeList.push_back(old);
+        count--;
+
+        // Pass 1 - link pairs left to right
+        int m = 0;
+        for(int i = 0; i + 1 < (int)scratch.size(); i += 2)
+            scratch[m++] = link(scratch[i], scratch[i + 1]);
+        if(scratch.size() % 2 == 1)
+            scratch[m++] = scratch.back();
+        // Pass 2 - link the results right to left
+        root = m == 0 ? -1 : scratch[m - 1];
+        for(int i = m - 2; i >= 0; i--)
+            root = link(scratch[i], root);
+    }
+
+    // New value x of handle h must not come out later than the old value (smaller for a min heap)
+    void decreaseKey(Handle h, T x){
+        node(h).value = move(x);
+        if(h == root)
+            return;
+        // Cut h (with its subtree) out of its parent's children list
+        Node &nh = node(h);
+        if(node(nh.prev).child == h)
+            node(nh.prev).child = nh.next;
+        else
+            node(nh.prev).next = nh.next;
+        if(nh.next != -1)
+            node(nh.next).prev = nh.prev;
+        nh.next = nh.prev = -1;
+        root = link(root, h);
+    }
+
+    // Moves all elements of other into this heap in O(1), other becomes empty and handles of both stay valid
+    // Returns false (and changes nothing) if other does not use the same arena, use pushAll() for that
+    bool meld(PairingHeap &other){
+        if(&other == this)  // Melding with itself - nothing to move
+            return true;
+        if(other.arena != arena)
+            return false;
+        if(other.root != -1)
+            root = root == -1 ? other.root : link(root, other.root);
+        count += other.count;
+        other.root = -1;
+        other.count = 0;
+        return true;
+    }
+
+    // Pushes every element of other (any arena) into this heap and empties other
+    // O(m logm) for m elements of other, handles of other are no longer valid
+    void pushAll(PairingHeap &other){
+        while(other.empty() == false){
+            push(other.top());
+            other.pop();
+        }
+    }
+};
+
+/* Benchmark - n random inserts and then n extractMin, Heap vs priority_queue
+for int and for 64 byte records
+*/
+void benchGenericHeap(int n){
+    mt19937 rng(1);
+    vector<int> keys(n);
+    for(int &k : keys)
+        k = rng();
+
+    auto timeIt = [](const char *name, function<long long()> run){
+        auto start = chrono::steady_clock::now();
+        long long check = run();
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << name << " : " << secs << " s (checksum " << check << ")" << endl;
+    };
+    timeIt("priority_queue<int>     ", [&]{
+        priority_queue<int, vector<int>, greater<int>> pq;
+        for(int k : keys)
+            pq.push(k);
+        long long sum = 0;
+        for(int i = 0; pq.empty() == false; i++){
+            sum += (long long)pq.top() * (i & 7);
+            pq.pop();
+        }
+        return sum;
+    });
+    timeIt("Heap<int>               ", [&]{
+        Heap<int> h;
+        for(int k : keys)
+            h.insert(k);
+        long long sum = 0;
+        int x;
+        for(int i = 0; h.extractMin(x); i++)
+            sum += (long long)x * (i & 7);
+        return sum;
+    });
+    timeIt("priority_queue<Record64>", [&]{
+        priority_queue<Record64, vector<Record64>, Record64Greater> pq;
+        for(int k : keys)
+            pq.push({k, {}});
+        long long sum = 0;
+        for(int i = 0; pq.empty() == false; i++){
+            sum += (long long)pq.top().key * (i & 7);
+            pq.pop();
+        }
+        return sum;
+    });
+    timeIt("Heap<Record64>          ", [&]{
+        Heap<Record64, KeyLess> h;
+        for(int k : keys)
+            h.insert({k, {}});
+        long long sum = 0;
+        Record64 r;
+        for(int i = 0; h.extractMin(r); i++)
+            sum += (long long)r.key * (i & 7);
+        return sum;
+    });
+}
+
+/* Throughput of one arity at one heap size (ns per operation)
+    - hold model: heap stays at size n, each step is extractMin followed by insert of (min + random), like Dijkstra / event queues
+    - decreaseKey: random position gets a smaller key and moves up
+Keys are long long - in the hold model keys only grow, an int key overflows after enough operations
+*/
+template<int Arity>
+void benchOneArity(int n, int ops){
+    mt19937 rng(7);
+    Heap<long long, less<long long>, Arity> h;
+    h.reserve(n);
+    for(int i = 0; i < n; i++)
+        h.insert(rng() >> 1);
+
+    auto start = chrono::steady_clock::now();
+    long long sum = 0, x = 0;
+    for(int i = 0; i < ops; i++){
+        h.extractMin(x);
+        sum += x;
+        h.insert(x + (rng() >> 12));
+    }
+    double hold = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / ops;
+
+    start = chrono::steady_clock::now();
+    for(int i = 0; i < ops; i++){
+        int pos = rng() % h.size();
+        h.decreaseKey(pos, h.arr[pos + h.ROOT] - (rng() & 1023));
+    }
+    double dec = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / ops;
+    h.getMin(x);
+
+    cout << "  " << Arity << "-ary : insert+extractMin " << hold << " ns, decreaseKey " << dec << " ns (check " << sum + x << ")" << endl;
+}
+
+// Heap sizes 2^12, 2^16, ... up to 2^maxLog - from L1 sized (32 KB of long long) to far past the last level cache
+// Default 2^27 keys = 1 GB, pick maxLog so that 8 * 2^maxLog bytes is several times the LLC of the machine
+void benchHeapArity(int ops, int maxLog = 27){
+    vector<int> sizes;
+    for(int lg = 12; lg < maxLog; lg += 4)
+        sizes.push_back(1 << lg);
+    sizes.push_back(1 << maxLog);
+    for(int n : sizes){
+        cout << "n = " << n << endl;
+        benchOneArity<2>(n, ops);
+        benchOneArity<4>(n, ops);
+        benchOneArity<8>(n, ops);
+    }
+}
+
+// Old recursive swap based heapify, kept only to compare against the hole based sift down
+void recursiveMaxHeapify(int arr[], int n, int i){
+    int lt = 2 * i + 1;
+    int rt = 2 * i + 2;
+    int maximum = i;
+    if(lt < n && arr[maximum] < arr[lt])
+        maximum = lt;
+    if(rt < n && arr[maximum] < arr[rt])
+        maximum = rt;
+    if(maximum != i){
+        swap(arr[i], arr[maximum]);
+        recursiveMaxHeapify(arr, n, maximum);
+    }
+}
+
+void recursiveSortHeap(int arr[], int n){
+    for(int i = (n - 2) / 2; i >= 0; i--)
+        recursiveMaxHeapify(arr, n, i);
+    for(int i = n - 1; i > 0; i--){
+        swap(arr[i], arr[0]);
+        recursiveMaxHeapify(arr, i, 0);
+    }
+}
+
+// Heap sort of random ints - recursive swap based vs iterative hole based (MinHeap::sortHeap)
+// Each size is sorted again and again till total elements sorted = 2^24, so small (in cache) sizes are timed properly
+void benchHeapify(){
+    MinHeap mh(1);
+    for(int n : { 1 << 10, 1 << 14, 1 << 18, 1 << 22 }){
+        mt19937 rng(5);
+        vector<int> src(n), a, b;
+        for(int &x : src)
+            x = rng();
+        double recursive = 0, hole = 0;
+        bool same = true;
+        for(int rep = 0; rep < (1 << 24) / n; rep++){
+            a = src;
+            b = src;
+            auto start = chrono::steady_clock::now();
+            recursiveSortHeap(a.data(), n);
+            recursive += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            start = chrono::steady_clock::now();
+            mh.sortHeap(b.data(), n);
+            hole += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            same = same && a == b;
+        }
+        cout << "n = " << n << " : recursive swap " << recursive << " s, hole based " << hole << " s, speedup " << recursive / hole;
+        cout << (same && is_sorted(b.begin(), b.end()) ? "" : " (WRONG RESULT)") << endl;
+    }
+}
+
+// Loading n random keys - n insert() calls vs plain Floyd build vs cache blocked Floyd vs small batches
+void benchHeapBuild(){
+    for(int n : { 1 << 16, 1 << 20, 1 << 24, 1 << 26 }){
+        mt19937 rng(11);
+        vector<int> keys(n);
+        for(int &k : keys)
+            k = rng();
+        int reps = max(1, (1 << 24) / n);
+        double inserts = 0, floyd = 0, blocked = 0, batches = 0;
+        long long check = 0;
+        for(int rep = 0; rep < reps; rep++){
+            auto start = chrono::steady_clock::now();
+            MinHeap a(n);
+            for(int k : keys)
+                a.insert(k);
+            inserts += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            start = chrono::steady_clock::now();
+            MinHeap b(n);
+            copy(keys.begin(), keys.end(), b.arr);
+            b.size = n;
+            for(int i = (n - 2) / 2; i >= 0; i--)
+                b.minHeapify(i);
+            floyd += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            start = chrono::steady_clock::now();
+            MinHeap c(n);
+            copy(keys.begin(), keys.end(), c.arr);
+            c.size = n;
+            c.buildBlocked(c.arr, n);   // Blocked at every size, buildMinHeap() would use plain Floyd below BLOCKED_MIN
+            blocked += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            // Many small batches into a heap that starts small and has to grow
+            start = chrono::steady_clock::now();
+            MinHeap d(1);
+            for(int i = 0; i < n; i += 4)
+                d.insertBatch(keys.begin() + i, keys.begin() + min(i + 4, n));
+            batches += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            check += (long long)a.getMin() + b.getMin() + c.getMin() + d.getMin();
+        }
+        cout << "n = " << n << " : " << n << " inserts " << inserts / reps << " s, Floyd " << floyd / reps;
+        cout << " s, blocked Floyd " << blocked / reps << " s, insertBatch of 4 keys " << batches / reps << " s (check " << check << ")" << endl;
+    }
+}
+
+/* Decrease key heavy workload (like Dijkstra on a dense graph) - n items, every round decreases 8 random items, then removes the minimum
+    - pairing heap - decreaseKey() on the handle
+    - array heap (Heap) - has no handles, so a decrease inserts the item again with the new key, old copies are skipped when they come out
+*/
+void benchPairingHeap(int n){
+    mt19937 rng(13);
+    vector<int> start(n);
+    for(int &k : start)
+        k = rng() >> 1;
+    vector<unsigned> picks(n * 8);
+    for(unsigned &p : picks)
+        p = rng();
+
+    auto t0 = chrono::steady_clock::now();
+    long long sumPairing = 0;
+    {
+        vector<int> key = start;
+        vector<char> done(n, 0);
+        PairingHeap<Keyed<int, int>, KeyGreater> ph;
+        vector<int> handle(n);
+        for(int i = 0; i < n; i++)
+            handle[i] = ph.push({ key[i], i });
+        for(int round = 0; ph.empty() == false; round++){
+            for(int j = 0; j < 8; j++){
+                int v = picks[(round * 8 + j) % picks.size()] % n;
+                if(done[v] == false){
+                    key[v] -= key[v] >> 4;
+                    ph.decreaseKey(handle[v], { key[v], v });
+                }
+            }
+            sumPairing += ph.top().key;
+            done[ph.top().value] = true;
+            ph.pop();
+        }
+    }
+    auto t1 = chrono::steady_clock::now();
+    long long sumArray = 0;
+    {
+        vector<int> key = start;
+        vector<char> done(n, 0);
+        Heap<Keyed<int, int>, KeyLess> h;
+        for(int i = 0; i < n; i++)
+            h.insert({ key[i], i });
+        for(int round = 0; h.empty() == false; round++){
+            for(int j = 0; j < 8; j++){
+                int v = picks[(round * 8 + j) % picks.size()] % n;
+                if(done[v] == false){
+                    key[v] -= key[v] >> 4;
+                    h.insert({ key[v], v });
+                }
+            }
+            Keyed<int, int> x = { 0, 0 };
+            while(h.extractMin(x) && (done[x.value] || x.key != key[x.value]))    // Skip old copies
+                ;
+            if(done[x.value] == false && x.key == key[x.value]){
+                sumArray += x.key;
+                done[x.value] = true;
+            }
+        }
+    }
+    auto t2 = chrono::steady_clock::now();
+    cout << "n = " << n << " : pairing heap " << chrono::duration<double>(t1 - t0).count() << " s, array heap (reinsert) ";
+    cout << chrono::duration<double>(t2 - t1).count() << " s, same result " << (sumPairing == sumArray) << endl;
+}
+//*******************************************************************************************************************************************
+
+/* ./heap                        - small example below
+   ./heap bench <name> [size]    - name = generic (size = n), arity (size = log2 of the biggest heap),
+                                   heapify, build, pairing (size = n) or all
+*/
+int main(int argc, char *argv[]){
+    if(argc > 1 && string(argv[1]) == "bench"){
+        string name = argc > 2 ? argv[2] : "all";
+        int size = argc > 3 ? atoi(argv[3]) : 0;
+        bool all = name == "all", found = false;
+        if(all || name == "generic"){
+            benchGenericHeap(size > 0 ? size : 1 << 20);
+            found = true;
+        }
+        if(all || name == "arity"){
+            benchHeapArity(2000000, size > 0 ? size : 27);
+            found = true;
+        }
+        if(all || name == "heapify"){
+            benchHeapify();
+            found = true;
+        }
+        if(all || name == "build"){
+            benchHeapBuild();
+            found = true;
+        }
+        if(all || name == "pairing"){
+            if(size > 0)
+                benchPairingHeap(size);
+            else{
+                for(int n : { 1 << 12, 1 << 16, 1 << 20 })
+                    benchPairingHeap(n);
+            }
+            found = true;
+        }
+        if(found == false){
+            cout << "unknown benchmark " << name << ", use generic, arity, heapify, build, pairing or all" << endl;
+            return 1;
+        }
+        return 0;
+    }
     MinHeap mh(5);
     vector<vector<int>> arr{ { 10, 20, 30 }, { 5, 15 }, { 1, 9, 11, 18 } };
     vector<int> res = mh.mergeKArrays2(arr);